@@ -0,0 +1,119 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GENUSYS_NUMSYS_ATTRACTOR_SIEVE_H_
+#define GENUSYS_NUMSYS_ATTRACTOR_SIEVE_H_
+
+#include <vector>
+
+#include "radix_properties.h"
+#include "vector_coder.h"
+
+// Largest magnitude of (base^j * z)[i] for which the enclosure uses the rows of base^j as directions
+#ifndef GENUSYS_ATTRACTOR_SIEVE_MAX_VALUE
+#define GENUSYS_ATTRACTOR_SIEVE_MAX_VALUE 1e12
+#endif
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        // Finds the points of the search space which are provably not periodic, so the scan can skip them
+        // without walking. Such points are either outside the enclosing polytope of the attractor given by
+        // Traits::getEnclosure (with the rows of base^j as directions), or their image under phi is out of the bounds.
+        // Both are slabs low <= v * z <= high, and the points of a row of the space (differing only in the first
+        // coordinate) inside every slab form a range of z[0], so the sieve works a whole row at once.
+        class AttractorSieve
+        {
+
+            private:
+
+                unsigned int length;
+
+                std::vector<int> lowerBound;
+
+                std::vector<unsigned int> varBase;
+
+                // The slabs, directions in row major order
+                std::vector<double> directions;
+
+                std::vector<double> low;
+
+                std::vector<double> high;
+
+                // The row of the last query, and the range of offsets in it which may be periodic
+                unsigned long long rowStart;
+
+                unsigned long long first;
+
+                unsigned long long last;
+
+                void addSlab(const std::vector<double>& direction, double low, double high);
+
+                void setRow(unsigned long long row);
+
+            public:
+
+                template <
+                    typename ElementType,
+                    template<typename> class VectorType
+                    >
+                AttractorSieve(const RadixProperties<ElementType>& props, const std::vector<VectorType<ElementType>>& digitSet, const VectorCoder& coder);
+
+                unsigned int getSlabCount() const
+                {
+                    return low.size();
+                }
+
+                // True if the point of code is proven not to be periodic
+                bool operator()(unsigned long long code)
+                {
+                    if (code - rowStart >= varBase[0])
+                    {
+                        setRow(code - code % varBase[0]);
+                    }
+                    unsigned long long offset = code - rowStart;
+
+                    return offset < first || offset > last;
+                }
+
+                // Sets [first, last] to the offsets of the points of the row starting at rowStart which may be periodic,
+                // returns false if there are none
+                bool getRow(unsigned long long rowStart, unsigned long long& first, unsigned long long& last)
+                {
+                    setRow(rowStart);
+                    first = this->first;
+                    last = this->last;
+
+                    return first <= last;
+                }
+
+                // The number of points of the search space which may be periodic
+                unsigned long long getCandidateCount();
+
+        };
+
+    }
+}
+
+// Include implementation
+#include "attractor_sieve.hpp"
+
+#endif // GENUSYS_NUMSYS_ATTRACTOR_SIEVE_H_
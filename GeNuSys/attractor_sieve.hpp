@@ -0,0 +1,191 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "element_traits.h"
+#include "numsys_traits.h"
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType
+            >
+        AttractorSieve::AttractorSieve(const RadixProperties<ElementType>& props, const std::vector<VectorType<ElementType>>& digitSet, const VectorCoder& coder):
+            length(props.getBase().getRows()), lowerBound(coder.getLowerBound()), varBase(length)
+        {
+            typedef typename ElementTraits<ElementType>::RationalType RationalType;
+
+            const GeNuSys::LinAlg::Matrix<RationalType>& invM = props.getInverse();
+
+            double maxCoord = 1.0;
+            for (unsigned int i = 0; i < length; ++i)
+            {
+                varBase[i] = coder.getUpperBound()[i] - coder.getLowerBound()[i] + 1;
+                maxCoord = std::max(maxCoord, (double) std::max(-coder.getLowerBound()[i], coder.getUpperBound()[i]));
+            }
+
+            // phi(z) is inside only if (invM * z)[i] is in the bounds of coordinate i, shifted by the range of
+            // (invM * digit)[i]. The image is an integer point, the margin of 1/2 covers the rounding errors.
+            std::vector<double> direction(length);
+            for (unsigned int i = 0; i < length; ++i)
+            {
+                double minDigit = 0.0, maxDigit = 0.0;
+                for (unsigned int d = 0; d < digitSet.size(); ++d)
+                {
+                    double value = 0.0;
+                    for (unsigned int j = 0; j < length; ++j)
+                    {
+                        value += ElementTraits<RationalType>::template asType<double>(invM(i, j) * ElementTraits<ElementType>::template asType<RationalType>(digitSet[d][j]));
+                    }
+                    minDigit = (d == 0) ? value : std::min(minDigit, value);
+                    maxDigit = (d == 0) ? value : std::max(maxDigit, value);
+                }
+                for (unsigned int j = 0; j < length; ++j)
+                {
+                    direction[j] = ElementTraits<RationalType>::template asType<double>(invM(i, j));
+                }
+                addSlab(direction, coder.getLowerBound()[i] + minDigit - 0.5, coder.getUpperBound()[i] + maxDigit + 0.5);
+            }
+
+            // The enclosure with the rows of base^j, as long as base^j * z is computed exactly in doubles. The
+            // directions are integer, so are the values, the margin covers the rounding errors of the bounds.
+            GeNuSys::LinAlg::Matrix<RationalType> power = props.getBase();
+            for (unsigned int j = 1; j <= length; ++j)
+            {
+                double maxValue = 0.0;
+                for (unsigned int r = 0; r < length; ++r)
+                {
+                    double rowSum = 0.0;
+                    for (unsigned int c = 0; c < length; ++c)
+                    {
+                        rowSum += std::fabs(ElementTraits<RationalType>::template asType<double>(power(r, c)));
+                    }
+                    maxValue = std::max(maxValue, rowSum * maxCoord);
+                }
+                if (maxValue > GENUSYS_ATTRACTOR_SIEVE_MAX_VALUE)
+                {
+                    break;
+                }
+
+                std::vector<RationalType> lower, upper;
+                Traits::getEnclosure(invM, digitSet, power, lower, upper);
+                for (unsigned int r = 0; r < length; ++r)
+                {
+                    for (unsigned int c = 0; c < length; ++c)
+                    {
+                        direction[c] = ElementTraits<RationalType>::template asType<double>(power(r, c));
+                    }
+                    double lowValue = ElementTraits<RationalType>::template asType<double>(lower[r]);
+                    double highValue = ElementTraits<RationalType>::template asType<double>(upper[r]);
+                    double margin = 1e-6 * (1.0 + std::max(std::fabs(lowValue), std::fabs(highValue)));
+                    addSlab(direction, lowValue - margin, highValue + margin);
+                }
+
+                power = power * GeNuSys::LinAlg::Matrix<RationalType>(props.getBase());
+            }
+
+            setRow(0);
+        }
+
+        inline void AttractorSieve::addSlab(const std::vector<double>& direction, double low, double high)
+        {
+            directions.insert(directions.end(), direction.begin(), direction.end());
+            this->low.push_back(low);
+            this->high.push_back(high);
+        }
+
+        inline void AttractorSieve::setRow(unsigned long long row)
+        {
+            rowStart = row;
+
+            std::vector<long long> z(length);
+            row /= varBase[0];
+            for (unsigned int j = 1; j < length; ++j)
+            {
+                z[j] = (long long) (row % varBase[j]) + lowerBound[j];
+                row /= varBase[j];
+            }
+
+            // Range of z[0] inside every slab
+            double from = lowerBound[0], to = lowerBound[0] + (double) varBase[0] - 1;
+            for (unsigned int s = 0; s < low.size() && from <= to; ++s)
+            {
+                const double* v = &directions[s * length];
+                double rest = 0.0;
+                for (unsigned int j = 1; j < length; ++j)
+                {
+                    rest += v[j] * z[j];
+                }
+                if (v[0] > 0.0)
+                {
+                    from = std::max(from, (low[s] - rest) / v[0]);
+                    to = std::min(to, (high[s] - rest) / v[0]);
+                }
+                else if (v[0] < 0.0)
+                {
+                    from = std::max(from, (high[s] - rest) / v[0]);
+                    to = std::min(to, (low[s] - rest) / v[0]);
+                }
+                else if (rest < low[s] || rest > high[s])
+                {
+                    to = from - 1.0;
+                }
+            }
+
+            if (from <= to && std::ceil(from) <= std::floor(to))
+            {
+                first = (unsigned long long) (std::ceil(from) - lowerBound[0]);
+                last = (unsigned long long) (std::floor(to) - lowerBound[0]);
+            }
+            else
+            {
+                first = varBase[0];
+                last = 0;
+            }
+        }
+
+        inline unsigned long long AttractorSieve::getCandidateCount()
+        {
+            unsigned long long size = 1;
+            for (unsigned int j = 0; j < length; ++j)
+            {
+                size *= varBase[j];
+            }
+
+            unsigned long long count = 0;
+            for (unsigned long long row = 0; row < size; row += varBase[0])
+            {
+                setRow(row);
+                if (first <= last)
+                {
+                    count += last - first + 1;
+                }
+            }
+
+            return count;
+        }
+
+    }
+}
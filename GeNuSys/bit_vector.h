@@ -21,12 +21,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define GENUSYS_NUMSYS_BIT_VECTOR_H_
 
 #include <vector>
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "mapped_file.h"
 
 namespace GeNuSys
 {
     namespace NumSys
     {
 
+        // Bit table, either in memory or, if a file name is given, in a memory mapped file
         class BitVector
         {
 
@@ -34,32 +40,175 @@ namespace GeNuSys
 
                 std::vector<unsigned long long> table;
 
+                std::unique_ptr<MappedFile> file;
+
+                unsigned long long* words;
+
+                unsigned long long wordCount;
+
             public:
 
-                BitVector(unsigned long long size): table(size / (sizeof(unsigned long long) * 8) + 1, 0) { }
+                BitVector(unsigned long long size, const std::string& fileName = std::string()): wordCount(size / (sizeof(unsigned long long) * 8) + 1)
+                {
+                    if (fileName.empty())
+                    {
+                        table.assign(wordCount, 0);
+                        words = table.data();
+                    }
+                    else
+                    {
+                        file.reset(new MappedFile(fileName, wordCount * sizeof(unsigned long long)));
+                        words = (unsigned long long*) file->data();
+                    }
+                }
+
+                BitVector(const BitVector&) = delete;
+
+                BitVector& operator =(const BitVector&) = delete;
 
                 bool operator [](unsigned long long idx) const
                 {
-                    unsigned int d = (int)(idx / (sizeof(unsigned long long) * 8));
+                    unsigned long long d = idx / (sizeof(unsigned long long) * 8);
                     unsigned int m = (int)(idx % (sizeof(unsigned long long) * 8));
 
-                    return (table[d] & ((unsigned long long) 1 << m)) != 0;
+                    return (words[d] & ((unsigned long long) 1 << m)) != 0;
                 }
 
                 void set(unsigned long long idx)
                 {
-                    unsigned int d = (int)(idx / (sizeof(unsigned long long) * 8));
+                    unsigned long long d = idx / (sizeof(unsigned long long) * 8);
                     unsigned int m = (int)(idx % (sizeof(unsigned long long) * 8));
 
-                    table[d] |= ((unsigned long long) 1 << m);
+                    words[d] |= ((unsigned long long) 1 << m);
                 }
 
                 void unset(unsigned long long idx)
                 {
-                    unsigned int d = (int)(idx / (sizeof(unsigned long long) * 8));
+                    unsigned long long d = idx / (sizeof(unsigned long long) * 8);
                     unsigned int m = (int)(idx % (sizeof(unsigned long long) * 8));
 
-                    table[d] &= ~((unsigned long long) 1 << m);
+                    words[d] &= ~((unsigned long long) 1 << m);
+                }
+
+                // Raw access to the words of the table, e.g. for saving and restoring it
+                unsigned long long getWordCount() const
+                {
+                    return wordCount;
+                }
+
+                unsigned long long getWord(unsigned long long d) const
+                {
+                    return words[d];
+                }
+
+                void setWord(unsigned long long d, unsigned long long value)
+                {
+                    words[d] = value;
+                }
+
+                // Hints that the bits [from, to) will be read soon, only has effect for file backed tables
+                void prefetch(unsigned long long from, unsigned long long to) const
+                {
+                    if (file)
+                    {
+                        file->prefetch(from / 8, to / 8 + 1);
+                    }
+                }
+
+        };
+
+        class AtomicBitVector
+        {
+
+            private:
+
+                static_assert(sizeof(std::atomic<unsigned long long>) == sizeof(unsigned long long), "std::atomic<unsigned long long> must not have extra storage");
+
+                std::unique_ptr<std::atomic<unsigned long long>[]> table;
+
+                std::unique_ptr<MappedFile> file;
+
+                std::atomic<unsigned long long>* words;
+
+                unsigned long long wordCount;
+
+            public:
+
+                AtomicBitVector(unsigned long long size, const std::string& fileName = std::string()): wordCount(size / (sizeof(unsigned long long) * 8) + 1)
+                {
+                    if (fileName.empty())
+                    {
+                        table = std::unique_ptr<std::atomic<unsigned long long>[]>(new std::atomic<unsigned long long>[wordCount]);
+                        for (unsigned long long i = 0; i < wordCount; ++i)
+                        {
+                            table[i].store(0, std::memory_order_relaxed);
+                        }
+                        words = table.get();
+                    }
+                    else
+                    {
+                        // A freshly mapped file is zero filled, which is a valid state of the atomics
+                        file.reset(new MappedFile(fileName, wordCount * sizeof(unsigned long long)));
+                        words = (std::atomic<unsigned long long>*) file->data();
+                    }
+                }
+
+                bool operator [](unsigned long long idx) const
+                {
+                    unsigned long long d = idx / (sizeof(unsigned long long) * 8);
+                    unsigned int m = (int)(idx % (sizeof(unsigned long long) * 8));
+
+                    return (words[d].load(std::memory_order_acquire) & ((unsigned long long) 1 << m)) != 0;
+                }
+
+                // Sets the bit and returns its previous value
+                bool testAndSet(unsigned long long idx)
+                {
+                    unsigned long long d = idx / (sizeof(unsigned long long) * 8);
+                    unsigned int m = (int)(idx % (sizeof(unsigned long long) * 8));
+
+                    return (words[d].fetch_or((unsigned long long) 1 << m, std::memory_order_acq_rel) & ((unsigned long long) 1 << m)) != 0;
+                }
+
+                void set(unsigned long long idx)
+                {
+                    unsigned long long d = idx / (sizeof(unsigned long long) * 8);
+                    unsigned int m = (int)(idx % (sizeof(unsigned long long) * 8));
+
+                    words[d].fetch_or((unsigned long long) 1 << m, std::memory_order_release);
+                }
+
+                void unset(unsigned long long idx)
+                {
+                    unsigned long long d = idx / (sizeof(unsigned long long) * 8);
+                    unsigned int m = (int)(idx % (sizeof(unsigned long long) * 8));
+
+                    words[d].fetch_and(~((unsigned long long) 1 << m), std::memory_order_release);
+                }
+
+                // Raw access to the words of the table, e.g. for saving and restoring it
+                unsigned long long getWordCount() const
+                {
+                    return wordCount;
+                }
+
+                unsigned long long getWord(unsigned long long d) const
+                {
+                    return words[d].load(std::memory_order_acquire);
+                }
+
+                void setWord(unsigned long long d, unsigned long long value)
+                {
+                    words[d].store(value, std::memory_order_release);
+                }
+
+                // Hints that the bits [from, to) will be read soon, only has effect for file backed tables
+                void prefetch(unsigned long long from, unsigned long long to) const
+                {
+                    if (file)
+                    {
+                        file->prefetch(from / 8, to / 8 + 1);
+                    }
                 }
 
         };
@@ -0,0 +1,144 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GENUSYS_NUMSYS_BRENT_WALK_H_
+#define GENUSYS_NUMSYS_BRENT_WALK_H_
+
+#include <vector>
+#include <unordered_set>
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        // Finds the cycle reached from a start point with Brent's cycle detection, in memory independent of the size
+        // of the search space. A walk stops early at the points of the cycles known to the walker, and at the points
+        // remembered in a small direct mapped cache of points whose orbit is known to lead to an invalid point or to
+        // a known cycle. Cache entries are overwritten by colliding points, but a cached point is always resolved.
+        class BrentWalk
+        {
+
+            private:
+
+                static const unsigned int cacheBits = 16;
+
+                // Number of points at the start of a walk stored in the cache when the walk is over
+                static const unsigned int prefixLength = 64;
+
+                std::vector<unsigned long long> cache;
+
+                std::unordered_set<unsigned long long> cyclePoints;
+
+                std::vector<unsigned long long> prefix;
+
+                static unsigned long long slot(unsigned long long code)
+                {
+                    return (code * 0x9e3779b97f4a7c15ULL) >> (64 - cacheBits);
+                }
+
+                void resolve()
+                {
+                    for (unsigned int k = 0; k < prefix.size(); ++k)
+                    {
+                        cache[slot(prefix[k])] = prefix[k];
+                    }
+                }
+
+            public:
+
+                // Codes of the points of the cycle found by the last walk
+                std::vector<unsigned long long> cycle;
+
+                // The codes are less than ~0ULL, so it marks an empty cache entry
+                BrentWalk(): cache(1ULL << cacheBits, ~0ULL)
+                {
+                    prefix.reserve(prefixLength);
+                }
+
+                // True if the orbit of the point is known not to lead to a new cycle
+                bool isResolved(unsigned long long code) const
+                {
+                    return cache[slot(code)] == code || cyclePoints.count(code) != 0;
+                }
+
+                void addCycle(const std::vector<unsigned long long>& knownCycle)
+                {
+                    cyclePoints.insert(knownCycle.begin(), knownCycle.end());
+                }
+
+                // Walks the orbit of start with lane 0 of the stepper, returns true and sets cycle if it ends in a
+                // cycle which is not known to the walker
+                template <typename Stepper>
+                bool walk(Stepper& stepper, unsigned long long start)
+                {
+                    prefix.clear();
+                    cycle.clear();
+                    prefix.push_back(start);
+
+                    stepper.load(0, start);
+                    unsigned long long tortoise = start, hare;
+                    bool valid;
+                    stepper.step(&hare, &valid);
+
+                    // The tortoise jumps to the hare whenever the number of steps since its last jump reaches the next
+                    // power of two, so the hare meets it within two rounds of the cycle
+                    unsigned long long power = 1, length = 1;
+                    while (true)
+                    {
+                        if (!valid || isResolved(hare))
+                        {
+                            resolve();
+                            return false;
+                        }
+                        if (hare == tortoise)
+                        {
+                            break;
+                        }
+                        if (prefix.size() < prefixLength)
+                        {
+                            prefix.push_back(hare);
+                        }
+                        if (power == length)
+                        {
+                            tortoise = hare;
+                            power *= 2;
+                            length = 0;
+                        }
+                        stepper.step(&hare, &valid);
+                        ++length;
+                    }
+
+                    cycle.push_back(hare);
+                    for (unsigned long long k = 1; k < length; ++k)
+                    {
+                        stepper.step(&hare, &valid);
+                        cycle.push_back(hare);
+                    }
+                    resolve();
+
+                    return true;
+                }
+
+        };
+
+    }
+}
+
+#endif // GENUSYS_NUMSYS_BRENT_WALK_H_
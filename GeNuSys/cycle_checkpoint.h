@@ -0,0 +1,208 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GENUSYS_NUMSYS_CYCLE_CHECKPOINT_H_
+#define GENUSYS_NUMSYS_CYCLE_CHECKPOINT_H_
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <stdexcept>
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        // State of an interrupted cycle search: the bounds of the searched box, a fingerprint of the number system
+        // and the options, the start point ranges not processed yet, the cycles found so far (as codes) and the set
+        // of visited points.
+        class CycleCheckpoint
+        {
+
+            private:
+
+                static unsigned long long magic()
+                {
+                    return 0x32544b43534e4547ULL; // "GENSCKT2"
+                }
+
+                std::streamoff visitedOffset;
+
+                template <typename T>
+                static void write(std::ofstream& out, const T& value)
+                {
+                    out.write((const char*) &value, sizeof(T));
+                }
+
+                template <typename T>
+                static void write(std::ofstream& out, const std::vector<T>& values)
+                {
+                    write(out, (unsigned long long) values.size());
+                    out.write((const char*) values.data(), values.size() * sizeof(T));
+                }
+
+                template <typename T>
+                static void read(std::ifstream& in, T& value)
+                {
+                    in.read((char*) &value, sizeof(T));
+                }
+
+                template <typename T>
+                static void read(std::ifstream& in, std::vector<T>& values)
+                {
+                    unsigned long long size = 0;
+                    read(in, size);
+                    if (!in)
+                    {
+                        return;
+                    }
+                    values.resize(size);
+                    in.read((char*) values.data(), size * sizeof(T));
+                }
+
+            public:
+
+                std::vector<int> lowerBound;
+
+                std::vector<int> upperBound;
+
+                unsigned long long fingerprint;
+
+                std::vector<std::pair<unsigned long long, unsigned long long>> ranges;
+
+                std::vector<std::vector<unsigned long long>> cycles;
+
+                CycleCheckpoint(): visitedOffset(0), fingerprint(0) {}
+
+                // Adds value to an FNV-1a hash
+                static void mix(unsigned long long& hash, unsigned long long value)
+                {
+                    for (unsigned int i = 0; i < 8; ++i, value >>= 8)
+                    {
+                        hash = (hash ^ (value & 0xff)) * 0x100000001b3ULL;
+                    }
+                }
+
+                // The file is written under a temporary name and renamed, so an interrupted save keeps the previous checkpoint
+                template <typename BitVectorType>
+                void save(const std::string& fileName, const BitVectorType& visited) const
+                {
+                    const std::string tmpName = fileName + ".tmp";
+                    {
+                        std::ofstream out(tmpName, std::ios::binary | std::ios::trunc);
+                        write(out, magic());
+                        write(out, lowerBound);
+                        write(out, upperBound);
+                        write(out, fingerprint);
+                        write(out, ranges);
+                        write(out, (unsigned long long) cycles.size());
+                        for (unsigned int i = 0; i < cycles.size(); ++i)
+                        {
+                            write(out, cycles[i]);
+                        }
+
+                        std::vector<unsigned long long> buffer;
+                        buffer.reserve(4096);
+                        write(out, visited.getWordCount());
+                        for (unsigned long long d = 0; d < visited.getWordCount(); ++d)
+                        {
+                            buffer.push_back(visited.getWord(d));
+                            if (buffer.size() == 4096 || d + 1 == visited.getWordCount())
+                            {
+                                out.write((const char*) buffer.data(), buffer.size() * sizeof(unsigned long long));
+                                buffer.clear();
+                            }
+                        }
+
+                        out.flush();
+                        if (!out)
+                        {
+                            throw std::runtime_error{"Cannot write checkpoint " + tmpName};
+                        }
+                    }
+                    if (std::rename(tmpName.c_str(), fileName.c_str()) != 0)
+                    {
+                        throw std::runtime_error{"Cannot rename checkpoint " + tmpName};
+                    }
+                }
+
+                // Reads everything but the visited set, which is restored by loadVisited
+                void load(const std::string& fileName)
+                {
+                    std::ifstream in(fileName, std::ios::binary);
+                    unsigned long long fileMagic = 0;
+                    read(in, fileMagic);
+                    if (!in || fileMagic != magic())
+                    {
+                        throw std::runtime_error{"Invalid checkpoint " + fileName};
+                    }
+                    read(in, lowerBound);
+                    read(in, upperBound);
+                    read(in, fingerprint);
+                    read(in, ranges);
+                    unsigned long long cycleCount = 0;
+                    read(in, cycleCount);
+                    cycles.assign(in ? cycleCount : 0, std::vector<unsigned long long>());
+                    for (unsigned long long i = 0; i < cycles.size(); ++i)
+                    {
+                        read(in, cycles[i]);
+                    }
+                    if (!in)
+                    {
+                        throw std::runtime_error{"Truncated checkpoint " + fileName};
+                    }
+                    visitedOffset = in.tellg();
+                }
+
+                template <typename BitVectorType>
+                void loadVisited(const std::string& fileName, BitVectorType& visited) const
+                {
+                    std::ifstream in(fileName, std::ios::binary);
+                    in.seekg(visitedOffset);
+                    unsigned long long wordCount = 0;
+                    read(in, wordCount);
+                    if (!in || wordCount != visited.getWordCount())
+                    {
+                        throw std::runtime_error{"Visited set of checkpoint " + fileName + " does not match"};
+                    }
+
+                    std::vector<unsigned long long> buffer(4096);
+                    for (unsigned long long d = 0; d < wordCount; d += buffer.size())
+                    {
+                        unsigned long long count = (wordCount - d < buffer.size()) ? wordCount - d : buffer.size();
+                        in.read((char*) buffer.data(), count * sizeof(unsigned long long));
+                        if (!in)
+                        {
+                            throw std::runtime_error{"Truncated checkpoint " + fileName};
+                        }
+                        for (unsigned long long k = 0; k < count; ++k)
+                        {
+                            visited.setWord(d + k, buffer[k]);
+                        }
+                    }
+                }
+
+        };
+
+    }
+}
+
+#endif // GENUSYS_NUMSYS_CYCLE_CHECKPOINT_H_
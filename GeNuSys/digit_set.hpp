@@ -93,9 +93,9 @@ namespace GeNuSys
             for (unsigned int i = 0; i < digits.size(); ++i)
             {
                 GeNuSys::LinAlg::Vector<ElementType> aV = props.getAdjoint() * digits[i];
-                GeNuSys::LinAlg::Operations::vct_mods(aV, props.getAbsDet());
+                GeNuSys::LinAlg::Operations::vct_mods(aV, props.getAbsDetDivider());
                 GeNuSys::LinAlg::Vector<ElementType> MaV = props.getBase() * aV;
-                GeNuSys::LinAlg::Operations::vct_idiv(MaV, props.getDet());
+                GeNuSys::LinAlg::Operations::vct_exdiv(MaV, props.getDetDivider());
 
                 result.push_back(MaV);
             }
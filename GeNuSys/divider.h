@@ -0,0 +1,108 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GENUSYS_DIVIDER_H_
+#define GENUSYS_DIVIDER_H_
+
+#include "element_traits.h"
+
+namespace GeNuSys
+{
+
+    // Division by a divisor fixed in advance. The general version simply forwards to ElementTraits,
+    // specializations precompute whatever makes the repeated division cheaper.
+    template<typename ElementType>
+    class Divider
+    {
+
+        private:
+
+            ElementType divisor;
+
+        public:
+
+            Divider();
+
+            Divider(const ElementType& divisor);
+
+            const ElementType& getDivisor() const;
+
+            // Same as ElementTraits<ElementType>::idiv(a, divisor)
+            ElementType quotient(const ElementType& a) const;
+
+            // Same as quotient(a), but a must be divisible by the divisor
+            ElementType exactQuotient(const ElementType& a) const;
+
+            // Same as ElementTraits<ElementType>::mod(a, divisor)
+            ElementType mod(const ElementType& a) const;
+
+            // Same as ElementTraits<ElementType>::mods(a, divisor)
+            ElementType mods(const ElementType& a) const;
+
+    };
+
+    // Replaces the hardware division by a multiplication with a precomputed constant: the inverse of the
+    // odd part of the divisor modulo 2^64 for exact quotients, and a Granlund-Montgomery magic number for
+    // truncating ones. The latter needs a 128 bit product, without it the hardware division is used.
+    template<>
+    class Divider<long long>
+    {
+
+        private:
+
+            long long divisor;
+
+            long long half;
+
+            unsigned long long inverse;
+
+            unsigned int shift;
+
+            long long magic;
+
+            unsigned int magicShift;
+
+            bool trivial;
+
+            static long long mulhs(long long a, long long b);
+
+        public:
+
+            Divider();
+
+            Divider(const long long& divisor);
+
+            const long long& getDivisor() const;
+
+            long long quotient(const long long& a) const;
+
+            long long exactQuotient(const long long& a) const;
+
+            long long mod(const long long& a) const;
+
+            long long mods(const long long& a) const;
+
+    };
+
+}
+
+// Include implementation
+#include "divider.hpp"
+
+#endif // GENUSYS_DIVIDER_H_
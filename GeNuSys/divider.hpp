@@ -0,0 +1,200 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+namespace GeNuSys
+{
+
+    template<typename ElementType>
+    Divider<ElementType>::Divider(): divisor(ElementTraits<ElementType>::one())
+    {
+    }
+
+    template<typename ElementType>
+    Divider<ElementType>::Divider(const ElementType& divisor): divisor(divisor)
+    {
+    }
+
+    template<typename ElementType>
+    const ElementType& Divider<ElementType>::getDivisor() const
+    {
+        return divisor;
+    }
+
+    template<typename ElementType>
+    ElementType Divider<ElementType>::quotient(const ElementType& a) const
+    {
+        return ElementTraits<ElementType>::idiv(a, divisor);
+    }
+
+    template<typename ElementType>
+    ElementType Divider<ElementType>::exactQuotient(const ElementType& a) const
+    {
+        return ElementTraits<ElementType>::idiv(a, divisor);
+    }
+
+    template<typename ElementType>
+    ElementType Divider<ElementType>::mod(const ElementType& a) const
+    {
+        return ElementTraits<ElementType>::mod(a, divisor);
+    }
+
+    template<typename ElementType>
+    ElementType Divider<ElementType>::mods(const ElementType& a) const
+    {
+        return ElementTraits<ElementType>::mods(a, divisor);
+    }
+
+    inline
+    Divider<long long>::Divider(): Divider(1)
+    {
+    }
+
+    inline
+    Divider<long long>::Divider(const long long& divisor): divisor(divisor), half(divisor / 2), inverse(0), shift(0), magic(0), magicShift(0)
+    {
+        const unsigned long long two63 = (unsigned long long) 1 << 63;
+        unsigned long long ad = (divisor < 0) ? -(unsigned long long) divisor : divisor;
+
+        trivial = (ad < 2);
+        if (divisor == 0)
+        {
+            return;
+        }
+
+        // Exact division: a = q * 2^shift * odd, so q = (a >> shift) * odd^-1 mod 2^64
+        unsigned long long odd = divisor;
+        while ((odd & 1) == 0)
+        {
+            odd = (unsigned long long)((long long) odd >> 1);
+            ++shift;
+        }
+        inverse = odd;
+        for (int i = 0; i < 5; ++i)
+        {
+            inverse *= 2 - odd * inverse;
+        }
+
+        if (trivial)
+        {
+            return;
+        }
+
+        // Signed magic number, see Hacker's Delight 10-4
+        unsigned long long t = two63 + ((unsigned long long) divisor >> 63);
+        unsigned long long anc = t - 1 - t % ad;
+        unsigned int p = 63;
+        unsigned long long q1 = two63 / anc;
+        unsigned long long r1 = two63 - q1 * anc;
+        unsigned long long q2 = two63 / ad;
+        unsigned long long r2 = two63 - q2 * ad;
+        unsigned long long delta;
+        do
+        {
+            ++p;
+            q1 *= 2;
+            r1 *= 2;
+            if (r1 >= anc)
+            {
+                ++q1;
+                r1 -= anc;
+            }
+            q2 *= 2;
+            r2 *= 2;
+            if (r2 >= ad)
+            {
+                ++q2;
+                r2 -= ad;
+            }
+            delta = ad - r2;
+        }
+        while (q1 < delta || (q1 == delta && r1 == 0));
+
+        magic = (long long)(q2 + 1);
+        if (divisor < 0)
+        {
+            magic = (long long)(-(q2 + 1));
+        }
+        magicShift = p - 64;
+    }
+
+    inline
+    long long Divider<long long>::mulhs(long long a, long long b)
+    {
+#ifdef __SIZEOF_INT128__
+        __extension__ typedef __int128 LongLongLong;
+        return (long long)(((LongLongLong) a * b) >> 64);
+#else
+        (void) a;
+        (void) b;
+        return 0;
+#endif // __SIZEOF_INT128__
+    }
+
+    inline
+    const long long& Divider<long long>::getDivisor() const
+    {
+        return divisor;
+    }
+
+    inline
+    long long Divider<long long>::quotient(const long long& a) const
+    {
+#ifdef __SIZEOF_INT128__
+        if (trivial)
+        {
+            return (divisor != 0) ? a * divisor : a / divisor;
+        }
+
+        long long q = mulhs(magic, a);
+        if (divisor > 0 && magic < 0)
+        {
+            q = (long long)((unsigned long long) q + (unsigned long long) a);
+        }
+        else if (divisor < 0 && magic > 0)
+        {
+            q = (long long)((unsigned long long) q - (unsigned long long) a);
+        }
+        q >>= magicShift;
+        return q + (long long)((unsigned long long) q >> 63);
+#else
+        return a / divisor;
+#endif // __SIZEOF_INT128__
+    }
+
+    inline
+    long long Divider<long long>::exactQuotient(const long long& a) const
+    {
+        return (long long)((unsigned long long)(a >> shift) * inverse);
+    }
+
+    inline
+    long long Divider<long long>::mod(const long long& a) const
+    {
+        long long r = a - quotient(a) * divisor;
+        return (r != 0 && ((r < 0) != (divisor < 0))) ? r + divisor : r;
+    }
+
+    inline
+    long long Divider<long long>::mods(const long long& a) const
+    {
+        long long m = mod(a);
+        return (m > half) ? m - divisor : m;
+    }
+
+}
@@ -0,0 +1,164 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GENUSYS_NUMSYS_DOMAIN_CODER_H_
+#define GENUSYS_NUMSYS_DOMAIN_CODER_H_
+
+#include <vector>
+#include <complex>
+
+#include "vector.h"
+#include "radix_properties.h"
+#include "vector_coder.h"
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        // Domain coder (see VectorCoder) of the points of a box for which the points in each row of the box (differing
+        // only in the first coordinate) form a range. Only the non-empty rows are stored, so the domain coder saves
+        // memory and time if the domain is much smaller than the box and the rows are long.
+        class RowCoder
+        {
+
+            private:
+
+                VectorCoder box;
+
+                unsigned long long rowLength;
+
+                // Bit r is set if row r has points in the domain, rowRank[w] is the number of such rows before word w
+                std::vector<unsigned long long> rowBits;
+
+                std::vector<unsigned long long> rowRank;
+
+                // For every non-empty row: its index, the offsets of its first and last point in the domain, and the code
+                // of its first point. rowCode has an extra element, the size of the domain.
+                std::vector<unsigned long long> rowIndex;
+
+                std::vector<unsigned int> first;
+
+                std::vector<unsigned int> last;
+
+                std::vector<unsigned long long> rowCode;
+
+                // Sets idx to the position of row among the non-empty rows, returns false if row is empty
+                bool rank(unsigned long long row, unsigned long long& idx) const;
+
+            protected:
+
+                RowCoder(): box(std::vector<int>(), std::vector<int>())
+                {
+                }
+
+                // The range of every row is given by range(rowStart, first, last), see AttractorSieve::getRow
+                template <typename RowRange>
+                void init(const std::vector<int>& lowerBound, const std::vector<int>& upperBound, RowRange& range);
+
+            public:
+
+                unsigned long long getSize() const
+                {
+                    return rowCode.back();
+                }
+
+                const VectorCoder& getBox() const
+                {
+                    return box;
+                }
+
+                const std::vector<int>& getLowerBound() const
+                {
+                    return box.getLowerBound();
+                }
+
+                const std::vector<int>& getUpperBound() const
+                {
+                    return box.getUpperBound();
+                }
+
+                unsigned long long toBox(unsigned long long code) const;
+
+                unsigned long long fromBox(unsigned long long boxCode, bool& valid) const;
+
+                template<typename ElementType>
+                unsigned long long encode(const GeNuSys::LinAlg::Vector<ElementType>& z, bool& valid) const;
+
+                template<typename ElementType>
+                void decode(unsigned long long code, GeNuSys::LinAlg::Vector<ElementType>& z) const;
+
+                template<typename ElementType>
+                void increment(GeNuSys::LinAlg::Vector<ElementType>& z) const;
+
+        };
+
+        // The points of the box of Traits::getBounds which may be periodic according to AttractorSieve, i.e. the points
+        // of an enclosing polytope of the attractor
+        class PolytopeCoder: public RowCoder
+        {
+
+            public:
+
+                template <
+                    typename ElementType,
+                    template<typename> class VectorType
+                    >
+                PolytopeCoder(const RadixProperties<ElementType>& props, const std::vector<VectorType<ElementType>>& digitSet);
+
+        };
+
+        // The points of the box of Traits::getBounds in the ball of the operator norm of the properties enclosing the
+        // attractor. The ball is the intersection of elliptic cylinders |(S * z)[i]| <= r.
+        class EllipsoidCoder: public RowCoder
+        {
+
+            private:
+
+                struct BallRange
+                {
+                    VectorCoder box;
+
+                    // S in row major order
+                    std::vector<std::complex<double>> S;
+
+                    double radius;
+
+                    BallRange(const VectorCoder& box): box(box) {}
+
+                    bool operator()(unsigned long long rowStart, unsigned long long& first, unsigned long long& last) const;
+                };
+
+            public:
+
+                template <
+                    typename ElementType,
+                    template<typename> class VectorType
+                    >
+                EllipsoidCoder(const RadixProperties<ElementType>& props, const std::vector<VectorType<ElementType>>& digitSet);
+
+        };
+
+    }
+}
+
+// Include implementation
+#include "domain_coder.hpp"
+
+#endif // GENUSYS_NUMSYS_DOMAIN_CODER_H_
@@ -0,0 +1,244 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <stdexcept>
+
+#include "element_traits.h"
+#include "numsys_traits.h"
+#include "attractor_sieve.h"
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        template <typename RowRange>
+        void RowCoder::init(const std::vector<int>& lowerBound, const std::vector<int>& upperBound, RowRange& range)
+        {
+            box = VectorCoder(lowerBound, upperBound);
+            rowLength = upperBound[0] - lowerBound[0] + 1;
+
+            unsigned long long rows = box.getSize() / rowLength;
+            rowBits.assign((rows + 63) / 64, 0);
+            rowRank.assign(rowBits.size(), 0);
+            rowCode.assign(1, 0);
+            for (unsigned long long row = 0; row < rows; ++row)
+            {
+                if (row % 64 == 0)
+                {
+                    rowRank[row / 64] = rowIndex.size();
+                }
+
+                unsigned long long from, to;
+                if (!range(row * rowLength, from, to))
+                {
+                    continue;
+                }
+                rowBits[row / 64] |= 1ULL << (row % 64);
+                rowIndex.push_back(row);
+                first.push_back((unsigned int) from);
+                last.push_back((unsigned int) to);
+                rowCode.push_back(rowCode.back() + (to - from + 1));
+            }
+        }
+
+        inline bool RowCoder::rank(unsigned long long row, unsigned long long& idx) const
+        {
+            unsigned long long word = rowBits[row / 64];
+            unsigned int bit = row % 64;
+            if (!((word >> bit) & 1))
+            {
+                return false;
+            }
+            idx = rowRank[row / 64] + std::bitset<64>(word & ((1ULL << bit) - 1)).count();
+
+            return true;
+        }
+
+        inline unsigned long long RowCoder::toBox(unsigned long long code) const
+        {
+            unsigned long long idx = std::upper_bound(rowCode.begin(), rowCode.end(), code) - rowCode.begin() - 1;
+
+            return rowIndex[idx] * rowLength + first[idx] + (code - rowCode[idx]);
+        }
+
+        inline unsigned long long RowCoder::fromBox(unsigned long long boxCode, bool& valid) const
+        {
+            if (!valid)
+            {
+                return 0;
+            }
+
+            unsigned long long row = boxCode / rowLength;
+            unsigned long long offset = boxCode - row * rowLength;
+            unsigned long long idx;
+            if (!rank(row, idx) || offset < first[idx] || offset > last[idx])
+            {
+                valid = false;
+                return 0;
+            }
+
+            return rowCode[idx] + (offset - first[idx]);
+        }
+
+        template<typename ElementType>
+        unsigned long long RowCoder::encode(const GeNuSys::LinAlg::Vector<ElementType>& z, bool& valid) const
+        {
+            unsigned long long boxCode = box.encode(z, valid);
+
+            return fromBox(boxCode, valid);
+        }
+
+        template<typename ElementType>
+        void RowCoder::decode(unsigned long long code, GeNuSys::LinAlg::Vector<ElementType>& z) const
+        {
+            box.decode(toBox(code), z);
+        }
+
+        template<typename ElementType>
+        void RowCoder::increment(GeNuSys::LinAlg::Vector<ElementType>& z) const
+        {
+            bool valid = true;
+            unsigned long long boxCode = box.encode(z, valid);
+            unsigned long long row = boxCode / rowLength;
+            unsigned long long idx = 0;
+            if (!valid || !rank(row, idx))
+            {
+                throw std::logic_error{"RowCoder::increment called with a point outside of the domain"};
+            }
+            if (boxCode - row * rowLength < last[idx])
+            {
+                z.set(0, z[0] + ElementTraits<ElementType>::one());
+                return;
+            }
+            decode((idx + 1 < rowIndex.size()) ? rowCode[idx + 1] : 0, z);
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType
+            >
+        PolytopeCoder::PolytopeCoder(const RadixProperties<ElementType>& props, const std::vector<VectorType<ElementType>>& digitSet)
+        {
+            std::vector<int> lowerBound, upperBound;
+            Traits::getBounds(props.getInverse(), digitSet, lowerBound, upperBound);
+            AttractorSieve sieve(props, digitSet, VectorCoder(lowerBound, upperBound));
+            auto range = [&sieve](unsigned long long rowStart, unsigned long long& first, unsigned long long& last)
+            {
+                return sieve.getRow(rowStart, first, last);
+            };
+            init(lowerBound, upperBound, range);
+        }
+
+        inline bool EllipsoidCoder::BallRange::operator()(unsigned long long rowStart, unsigned long long& first, unsigned long long& last) const
+        {
+            const unsigned int N = box.getLowerBound().size();
+
+            GeNuSys::LinAlg::Vector<long long> z(N);
+            box.decode(rowStart, z);
+
+            // |s * z[0] + w|^2 <= radius^2 for every row s of S, where w is the sum of the other terms
+            double from = box.getLowerBound()[0], to = box.getUpperBound()[0];
+            for (unsigned int i = 0; i < N && from <= to; ++i)
+            {
+                std::complex<double> s = S[i * N];
+                std::complex<double> w = 0.0;
+                for (unsigned int j = 1; j < N; ++j)
+                {
+                    w += S[i * N + j] * (double) z[j];
+                }
+                double a = std::norm(s);
+                double b = (std::conj(s) * w).real();
+                double c = std::norm(w) - radius * radius;
+                if (a == 0.0)
+                {
+                    if (c > 0.0)
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+                double disc = b * b - a * c;
+                if (disc < 0.0)
+                {
+                    return false;
+                }
+                from = std::max(from, (-b - std::sqrt(disc)) / a);
+                to = std::min(to, (-b + std::sqrt(disc)) / a);
+            }
+
+            if (from > to || std::ceil(from) > std::floor(to))
+            {
+                return false;
+            }
+            first = (unsigned long long) (std::ceil(from) - box.getLowerBound()[0]);
+            last = (unsigned long long) (std::floor(to) - box.getLowerBound()[0]);
+
+            return true;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType
+            >
+        EllipsoidCoder::EllipsoidCoder(const RadixProperties<ElementType>& props, const std::vector<VectorType<ElementType>>& digitSet)
+        {
+            typedef typename ElementTraits<ElementType>::RationalType RationalType;
+
+            std::vector<int> lowerBound, upperBound;
+            Traits::getBounds(props.getInverse(), digitSet, lowerBound, upperBound);
+            BallRange range(VectorCoder(lowerBound, upperBound));
+
+            // A periodic point is -sum(invM^k * digit_k) for k >= 1, so its norm is at most c / (1 - c) times the
+            // largest norm of a digit, where c is the norm of invM
+            typedef GeNuSys::LinAlg::OperatorNorm<RationalType> NormClass;
+            typedef typename NormClass::template NormType<RationalType>::Type NormType;
+            typedef typename ElementTraits<typename ElementTraits<RationalType>::ComplexType>::RealType ComplexRealType;
+            const NormClass& norm = props.getOperatorNorm();
+            double c = ElementTraits<NormType>::template asType<double>(norm.norm(props.getInverse()));
+            if (c >= 1.0)
+            {
+                throw std::runtime_error{"The operator norm of the inverse of the base is not less than 1"};
+            }
+            double maxDigit = 0.0;
+            for (unsigned int d = 0; d < digitSet.size(); ++d)
+            {
+                GeNuSys::LinAlg::Vector<RationalType> digit = digitSet[d];
+                maxDigit = std::max(maxDigit, ElementTraits<NormType>::template asType<double>(norm.norm(digit)));
+            }
+            range.radius = (1.0 + 1e-9) * maxDigit * c / (1.0 - c) + 1e-9;
+
+            const unsigned int N = lowerBound.size();
+            range.S.resize(N * N);
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    range.S[i * N + j] = ElementTraits<ComplexRealType>::template asType<double>(norm.getS()(i, j));
+                }
+            }
+
+            init(lowerBound, upperBound, range);
+        }
+
+    }
+}
@@ -47,6 +47,17 @@ namespace GeNuSys
 
     };
 
+    // The exact integer type in which the fraction-free eliminations of LinAlg::Algorithms work on matrices of
+    // ElementType, void if ElementType is not integral. The intermediate minors of a matrix can be much larger than its
+    // entries, so machine integers use an arbitrary precision type.
+    template<typename ElementType>
+    struct FractionFreeType
+    {
+
+        typedef void Type;
+
+    };
+
     template<typename ElementType>
     struct ElementTraits : ElementTypeTraits<ElementType>
     {
@@ -100,10 +111,12 @@ namespace GeNuSys
 #include "element_traits_long_int.hpp"
 #include "element_traits_double.hpp"
 #include "element_traits_complex.hpp"
+#include "element_traits_int128.hpp"
 #ifdef __unix__
 #include "element_traits_mpz.hpp"
 #include "element_traits_mpq.hpp"
 #include "element_traits_mpf.hpp"
+#include "element_traits_hybrid_integer.hpp"
 #endif // __unix__
 
 #endif // GENUSYS_ELEMENT_TRAITS_H_
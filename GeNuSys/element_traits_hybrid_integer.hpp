@@ -0,0 +1,345 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdexcept>
+#include <complex>
+
+#include "hybrid_integer.h"
+
+namespace GeNuSys
+{
+
+    // The rational and real types are those of mpz_class, the integer operations stay inline for small values
+    template<>
+    struct ElementTypeTraits<HybridInteger>
+    {
+
+        typedef mpf_class RealType;
+
+        typedef mpq_class RationalType;
+
+        typedef std::complex<HybridInteger> ComplexType;
+
+        typedef HybridInteger AbsType;
+
+        typedef HybridInteger AbsSqrType;
+
+    };
+
+    template<>
+    struct FractionFreeType<HybridInteger>
+    {
+
+        typedef HybridInteger Type;
+
+    };
+
+    template<>
+    struct FractionFreeType<int>
+    {
+
+        typedef HybridInteger Type;
+
+    };
+
+    template<>
+    struct FractionFreeType<long>
+    {
+
+        typedef HybridInteger Type;
+
+    };
+
+    template<>
+    struct FractionFreeType<long long>
+    {
+
+        typedef HybridInteger Type;
+
+    };
+
+    template<>
+    inline
+    const HybridInteger& ElementTraits<HybridInteger>::zero()
+    {
+        static const HybridInteger zero(0);
+        return zero;
+    }
+
+    template<>
+    inline
+    const HybridInteger& ElementTraits<HybridInteger>::one()
+    {
+        static const HybridInteger one(1);
+        return one;
+    }
+
+    template<>
+    template<>
+    inline
+    HybridInteger ElementTraits<HybridInteger>::asType<HybridInteger>(const HybridInteger& value)
+    {
+        return value;
+    }
+
+    template<>
+    template<>
+    inline
+    double ElementTraits<HybridInteger>::asType<double>(const HybridInteger& value)
+    {
+        return value.toDouble();
+    }
+
+    template<>
+    template<>
+    inline
+    mpz_class ElementTraits<HybridInteger>::asType<mpz_class>(const HybridInteger& value)
+    {
+        return value.toMpz();
+    }
+
+    template<>
+    template<>
+    inline
+    mpq_class ElementTraits<HybridInteger>::asType<mpq_class>(const HybridInteger& value)
+    {
+        return mpq_class(value.toMpz());
+    }
+
+    template<>
+    template<>
+    inline
+    mpf_class ElementTraits<HybridInteger>::asType<mpf_class>(const HybridInteger& value)
+    {
+        return mpf_class(value.toMpz());
+    }
+
+    template<>
+    template<>
+    inline
+    std::complex<HybridInteger> ElementTraits<HybridInteger>::asType<std::complex<HybridInteger>>(const HybridInteger& value)
+    {
+        return std::complex<HybridInteger>(value, HybridInteger(0));
+    }
+
+    template<>
+    template<>
+    inline
+    std::complex<mpq_class> ElementTraits<HybridInteger>::asType<std::complex<mpq_class>>(const HybridInteger& value)
+    {
+        return std::complex<mpq_class>(mpq_class(value.toMpz()), mpq_class(0));
+    }
+
+    template<>
+    template<>
+    inline
+    std::complex<mpf_class> ElementTraits<HybridInteger>::asType<std::complex<mpf_class>>(const HybridInteger& value)
+    {
+        return std::complex<mpf_class>(mpf_class(value.toMpz()), mpf_class(0));
+    }
+
+    template<>
+    template<>
+    inline
+    long long ElementTraits<HybridInteger>::asTypeUnsafe<long long>(const HybridInteger& value)
+    {
+        if (value.isSmall())
+        {
+            return value.getSmall();
+        }
+        else
+        {
+            throw std::out_of_range{"Conversion to long long failed: out of range"};
+        }
+    }
+
+    template<>
+    template<>
+    inline
+    long int ElementTraits<HybridInteger>::asTypeUnsafe<long int>(const HybridInteger& value)
+    {
+        return ElementTraits<mpz_class>::asTypeUnsafe<long int>(value.toMpz());
+    }
+
+    template<>
+    template<>
+    inline
+    int ElementTraits<HybridInteger>::asTypeUnsafe<int>(const HybridInteger& value)
+    {
+        return ElementTraits<mpz_class>::asTypeUnsafe<int>(value.toMpz());
+    }
+
+    template<>
+    template<>
+    inline
+    unsigned long int ElementTraits<HybridInteger>::asTypeUnsafe<unsigned long int>(const HybridInteger& value)
+    {
+        if (value.isSmall() && value.getSmall() >= 0)
+        {
+            return (unsigned long int) value.getSmall();
+        }
+
+        return ElementTraits<mpz_class>::asTypeUnsafe<unsigned long int>(value.toMpz());
+    }
+
+    template<>
+    template<>
+    inline
+    HybridInteger ElementTraits<int>::asType<HybridInteger>(const int& value)
+    {
+        return HybridInteger(value);
+    }
+
+    template<>
+    template<>
+    inline
+    HybridInteger ElementTraits<long>::asType<HybridInteger>(const long& value)
+    {
+        return HybridInteger(value);
+    }
+
+    template<>
+    template<>
+    inline
+    HybridInteger ElementTraits<long long>::asType<HybridInteger>(const long long& value)
+    {
+        return HybridInteger(value);
+    }
+
+    template<>
+    template<>
+    inline
+    HybridInteger ElementTraits<mpz_class>::asType<HybridInteger>(const mpz_class& value)
+    {
+        return HybridInteger(value);
+    }
+
+    template<>
+    template<>
+    inline
+    HybridInteger ElementTraits<mpq_class>::asTypeUnsafe<HybridInteger>(const mpq_class& value)
+    {
+        return HybridInteger(ElementTraits<mpq_class>::asTypeUnsafe<mpz_class>(value));
+    }
+
+#ifdef __SIZEOF_INT128__
+
+    template<>
+    struct FractionFreeType<Int128>
+    {
+
+        typedef HybridInteger Type;
+
+    };
+
+    template<>
+    template<>
+    inline
+    HybridInteger ElementTraits<Int128>::asType<HybridInteger>(const Int128& value)
+    {
+        return HybridInteger(ElementTraits<Int128>::asType<mpz_class>(value));
+    }
+
+    template<>
+    template<>
+    inline
+    Int128 ElementTraits<HybridInteger>::asTypeUnsafe<Int128>(const HybridInteger& value)
+    {
+        if (value.isSmall())
+        {
+            return value.getSmall();
+        }
+
+        return ElementTraits<mpz_class>::asTypeUnsafe<Int128>(value.toMpz());
+    }
+
+#endif // __SIZEOF_INT128__
+
+    template<>
+    inline
+    HybridInteger ElementTraits<HybridInteger>::abs(const HybridInteger& value)
+    {
+        return (value.sign() < 0) ? -value : value;
+    }
+
+    template<>
+    inline
+    HybridInteger ElementTraits<HybridInteger>::absSqr(const HybridInteger& value)
+    {
+        return value * value;
+    }
+
+    template<>
+    inline
+    mpf_class ElementTraits<HybridInteger>::sqrt(const HybridInteger& value)
+    {
+        return ElementTraits<mpz_class>::sqrt(value.toMpz());
+    }
+
+    template<>
+    inline
+    mpq_class ElementTraits<HybridInteger>::div(const HybridInteger& a, const HybridInteger& b)
+    {
+        return ElementTraits<mpz_class>::div(a.toMpz(), b.toMpz());
+    }
+
+    template<>
+    inline
+    bool ElementTraits<HybridInteger>::divisible(const HybridInteger& a, const HybridInteger& b)
+    {
+        return (a % b) == 0;
+    }
+
+    // Rounds towards negative infinity, like the mpz_class version
+    template<>
+    inline
+    HybridInteger ElementTraits<HybridInteger>::idiv(const HybridInteger& a, const HybridInteger& b)
+    {
+        HybridInteger q = a / b;
+        if ((a.sign() < 0) != (b.sign() < 0) && q * b != a)
+        {
+            q -= 1;
+        }
+
+        return q;
+    }
+
+    // The result is in [0, |b|), like the mpz_class version
+    template<>
+    inline
+    HybridInteger ElementTraits<HybridInteger>::mod(const HybridInteger& a, const HybridInteger& b)
+    {
+        HybridInteger r = a % b;
+        if (r.sign() < 0)
+        {
+            return (b.sign() < 0) ? r - b : r + b;
+        }
+
+        return r;
+    }
+
+    template<>
+    inline
+    HybridInteger ElementTraits<HybridInteger>::mods(const HybridInteger& a, const HybridInteger& b)
+    {
+        HybridInteger m = mod(a, b);
+        return (m > b / 2) ? m - b : m;
+    }
+
+}
@@ -0,0 +1,238 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <complex>
+
+#ifdef __unix__
+#include <gmpxx.h>
+#endif // __unix__
+
+#ifdef __SIZEOF_INT128__
+
+namespace GeNuSys
+{
+
+    // 128 bit integers for bases whose adjoint does not fit into long long, __extension__ keeps -pedantic quiet
+    __extension__ typedef __int128 Int128;
+
+    __extension__ typedef unsigned __int128 UInt128;
+
+    // The inverse and the bounds are exact where GMP is available, the conversions are in element_traits_mpq.hpp
+    template<>
+    struct ElementTypeTraits<Int128>
+    {
+
+        typedef double RealType;
+
+#ifdef __unix__
+        typedef mpq_class RationalType;
+#else
+        typedef double RationalType;
+#endif
+
+        typedef std::complex<Int128> ComplexType;
+
+        typedef Int128 AbsType;
+
+        typedef Int128 AbsSqrType;
+
+    };
+
+    template<>
+    inline
+    const Int128& ElementTraits<Int128>::zero()
+    {
+        static const Int128 zero = 0;
+        return zero;
+    }
+
+    template<>
+    inline
+    const Int128& ElementTraits<Int128>::one()
+    {
+        static const Int128 one = 1;
+        return one;
+    }
+
+    template<>
+    template<>
+    inline
+    Int128 ElementTraits<Int128>::asType<Int128>(const Int128& value)
+    {
+        return value;
+    }
+
+    template<>
+    template<>
+    inline
+    double ElementTraits<Int128>::asType<double>(const Int128& value)
+    {
+        return (double) value;
+    }
+
+    template<>
+    template<>
+    inline
+    std::complex<Int128> ElementTraits<Int128>::asType<std::complex<Int128>>(const Int128& value)
+    {
+        return std::complex<Int128>(value, 0);
+    }
+
+    template<>
+    template<>
+    inline
+    std::complex<double> ElementTraits<Int128>::asType<std::complex<double>>(const Int128& value)
+    {
+        return std::complex<double>((double) value, 0);
+    }
+
+    template<>
+    template<>
+    inline
+    unsigned long ElementTraits<Int128>::asTypeUnsafe<unsigned long>(const Int128& value)
+    {
+        return (unsigned long) value;
+    }
+
+    template<>
+    template<>
+    inline
+    int ElementTraits<Int128>::asTypeUnsafe<int>(const Int128& value)
+    {
+        return (int) value;
+    }
+
+    template<>
+    template<>
+    inline
+    long ElementTraits<Int128>::asTypeUnsafe<long>(const Int128& value)
+    {
+        return (long) value;
+    }
+
+    template<>
+    template<>
+    inline
+    long long ElementTraits<Int128>::asTypeUnsafe<long long>(const Int128& value)
+    {
+        return (long long) value;
+    }
+
+    template<>
+    template<>
+    inline
+    Int128 ElementTraits<int>::asType<Int128>(const int& value)
+    {
+        return value;
+    }
+
+    template<>
+    template<>
+    inline
+    Int128 ElementTraits<long>::asType<Int128>(const long& value)
+    {
+        return value;
+    }
+
+    template<>
+    template<>
+    inline
+    Int128 ElementTraits<long long>::asType<Int128>(const long long& value)
+    {
+        return value;
+    }
+
+    template<>
+    template<>
+    inline
+    Int128 ElementTraits<double>::asTypeUnsafe<Int128>(const double& value)
+    {
+        return (Int128) floor(value + 0.5);
+    }
+
+    template<>
+    inline
+    Int128 ElementTraits<Int128>::abs(const Int128& value)
+    {
+        return (value < 0) ? -value : value;
+    }
+
+    template<>
+    inline
+    Int128 ElementTraits<Int128>::absSqr(const Int128& value)
+    {
+        return value * value;
+    }
+
+    template<>
+    inline
+    double ElementTraits<Int128>::sqrt(const Int128& value)
+    {
+        return std::sqrt((double) value);
+    }
+
+    template<>
+    inline
+    double ElementTraits<Int128>::root(const Int128& value, int n)
+    {
+        return std::pow((double) value, 1.0 / n);
+    }
+
+#ifndef __unix__
+    template<>
+    inline
+    double ElementTraits<Int128>::div(const Int128& a, const Int128& b)
+    {
+        return (double) a / (double) b;
+    }
+#endif // __unix__
+
+    template<>
+    inline
+    bool ElementTraits<Int128>::divisible(const Int128& a, const Int128& b)
+    {
+        return a % b == 0;
+    }
+
+    template<>
+    inline
+    Int128 ElementTraits<Int128>::idiv(const Int128& a, const Int128& b)
+    {
+        return a / b;
+    }
+
+    template<>
+    inline
+    Int128 ElementTraits<Int128>::mod(const Int128& a, const Int128& b)
+    {
+        return (a % b + b) % b;
+    }
+
+    template<>
+    inline
+    Int128 ElementTraits<Int128>::mods(const Int128& a, const Int128& b)
+    {
+        Int128 m = mod(a, b);
+        return (m > b / 2) ? m - b : m;
+    }
+
+}
+
+#endif // __SIZEOF_INT128__
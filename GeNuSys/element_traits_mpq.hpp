@@ -132,6 +132,14 @@ namespace GeNuSys
         }
     }
 
+    template<>
+    template<>
+    inline
+    long long ElementTraits<mpq_class>::asTypeUnsafe<long long>(const mpq_class& value)
+    {
+        return ElementTraits<mpz_class>::asType<long long>(ElementTraits<mpq_class>::asTypeUnsafe<mpz_class>(value));
+    }
+
     template<>
     template<>
     inline
@@ -148,6 +156,41 @@ namespace GeNuSys
         return std::complex<mpq_class>(value, mpq_class(0));
     }
 
+#ifdef __SIZEOF_INT128__
+
+    template<>
+    template<>
+    inline
+    mpq_class ElementTraits<Int128>::asType<mpq_class>(const Int128& value)
+    {
+        return mpq_class(ElementTraits<Int128>::asType<mpz_class>(value));
+    }
+
+    template<>
+    template<>
+    inline
+    std::complex<mpq_class> ElementTraits<Int128>::asType<std::complex<mpq_class>>(const Int128& value)
+    {
+        return std::complex<mpq_class>(ElementTraits<Int128>::asType<mpq_class>(value), mpq_class(0));
+    }
+
+    template<>
+    template<>
+    inline
+    Int128 ElementTraits<mpq_class>::asTypeUnsafe<Int128>(const mpq_class& value)
+    {
+        return ElementTraits<mpz_class>::asTypeUnsafe<Int128>(ElementTraits<mpq_class>::asTypeUnsafe<mpz_class>(value));
+    }
+
+    template<>
+    inline
+    mpq_class ElementTraits<Int128>::div(const Int128& a, const Int128& b)
+    {
+        return ElementTraits<mpz_class>::div(ElementTraits<Int128>::asType<mpz_class>(a), ElementTraits<Int128>::asType<mpz_class>(b));
+    }
+
+#endif // __SIZEOF_INT128__
+
     template<>
     inline
     mpq_class ElementTraits<mpq_class>::abs(const mpq_class& value)
@@ -44,6 +44,14 @@ namespace GeNuSys
 
     };
 
+    template<>
+    struct FractionFreeType<mpz_class>
+    {
+
+        typedef mpz_class Type;
+
+    };
+
     template<>
     inline
     const mpz_class& ElementTraits<mpz_class>::zero()
@@ -122,6 +130,14 @@ namespace GeNuSys
         return ElementTraits<mpz_class>::asTypeUnsafe<long int>(value);
     }
 
+    template<>
+    template<>
+    inline
+    double ElementTraits<mpz_class>::asType<double>(const mpz_class& value)
+    {
+        return value.get_d();
+    }
+
     template<>
     template<>
     inline
@@ -200,6 +216,50 @@ namespace GeNuSys
     {
         return mpz_class(value);
     }
+
+#ifdef __SIZEOF_INT128__
+
+    // The magnitude is split into two 64 bit words
+    template<>
+    template<>
+    inline
+    mpz_class ElementTraits<Int128>::asType<mpz_class>(const Int128& value)
+    {
+        UInt128 magnitude = (value < 0) ? -(UInt128) value : (UInt128) value;
+        unsigned long long words[2] = {(unsigned long long) magnitude, (unsigned long long) (magnitude >> 64)};
+        mpz_class result;
+        mpz_import(result.get_mpz_t(), 2, -1, sizeof(unsigned long long), 0, 0, words);
+
+        return (value < 0) ? mpz_class(-result) : result;
+    }
+
+    template<>
+    template<>
+    inline
+    Int128 ElementTraits<mpz_class>::asTypeUnsafe<Int128>(const mpz_class& value)
+    {
+        // [-2^127, 2^127 - 1], the magnitude of -2^127 only fits into UInt128
+        static const mpz_class limit = mpz_class(1) << 127;
+        if (value < -limit || value >= limit)
+        {
+            throw std::out_of_range{"Conversion to Int128 failed: out of range"};
+        }
+        unsigned long long words[2] = {0, 0};
+        mpz_export(words, nullptr, -1, sizeof(unsigned long long), 0, 0, value.get_mpz_t());
+        UInt128 magnitude = ((UInt128) words[1] << 64) | words[0];
+
+        return (Int128) ((mpz_sgn(value.get_mpz_t()) < 0) ? -magnitude : magnitude);
+    }
+
+    template<>
+    template<>
+    inline
+    Int128 ElementTraits<mpz_class>::asType<Int128>(const mpz_class& value)
+    {
+        return ElementTraits<mpz_class>::asTypeUnsafe<Int128>(value);
+    }
+
+#endif // __SIZEOF_INT128__
     
     template<>
     template<>
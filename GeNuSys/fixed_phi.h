@@ -0,0 +1,211 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GENUSYS_NUMSYS_FIXED_PHI_H_
+#define GENUSYS_NUMSYS_FIXED_PHI_H_
+
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <limits>
+
+#include "divider.h"
+#include "radix_properties.h"
+#include "smith_hash.h"
+#include "lookup_hash.h"
+#include "vector_coder.h"
+
+// Largest dimension for which the cycle search uses FixedPhi, 0 disables it
+#ifndef GENUSYS_FIXED_PHI_MAX_DIM
+#define GENUSYS_FIXED_PHI_MAX_DIM 16
+#endif
+
+// Number of orbits walked at once by a thread of the cycle search using FixedPhi, 1 walks a single orbit
+#ifndef GENUSYS_FIXED_PHI_LANES
+#define GENUSYS_FIXED_PHI_LANES 4
+#endif
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        // True if no intermediate value of phi overflows long long for the points of the box of coder: the bound
+        // is the sum of the absolute values of the products in U * z and adjoint * (z - digit)
+        template <
+            template<typename> class VectorType,
+            template<typename> class MatrixType
+            >
+        bool phiFitsLongLong(const RadixProperties<long long>& props, const SmithHash<long long, MatrixType>& smithHash,
+                             const std::vector<VectorType<long long>>& digitSet, const VectorCoder& coder);
+
+        // The phi function of a long long number system of dimension N on plain arrays, combined with
+        // the encoding of the result, so that an orbit step does not touch any Vector object.
+        template <unsigned int N>
+        class FixedPhi
+        {
+
+            private:
+
+                // The non-zero entries of the rows of the adjoint, companion-like bases have O(N) of them
+                long long adjValue[N][N];
+
+                unsigned int adjCol[N][N];
+
+                unsigned int adjCount[N];
+
+                Divider<long long> det;
+
+                // The rows of U beyond the size of the hash have G = 1 and prodG = 0, so they do not contribute
+                long long U[N][N];
+
+                Divider<long long> G[N];
+
+                long long prodG[N];
+
+                // Hashes the points of the search space by table lookups if the Smith invariants are small enough
+                LookupHash lookup;
+
+                std::vector<std::array<long long, N>> digits;
+
+                long long lowerBound[N];
+
+                long long upperBound[N];
+
+                unsigned long long varBase[N];
+
+                unsigned long long stride[N];
+
+                bool complete;
+
+                // Set if phiFitsLongLong fails, the steps then detect overflows and redo the affected lanes in mpz_class
+                bool checked;
+
+                unsigned long long hash(const long long (&z)[N]) const;
+
+                // Applies phi to z, returns false without changing z if an intermediate value overflows
+                bool stepChecked(long long (&z)[N]) const;
+
+                // Applies phi to z in mpz_class, a coordinate out of the box is replaced by a neighbour of the box
+                void stepExact(long long (&z)[N]) const;
+
+                template <unsigned int K>
+                void encode(const long long (&z)[N][K], unsigned long long* codes, bool* valid) const;
+
+                static long long getLookupRange(const VectorCoder& coder);
+
+            public:
+
+                // Walks K orbits at once, the coordinates are stored lane by lane so the steps of the lanes vectorize.
+                // FixedPhi works on the box of the domain coder, the codes of the stepper are the codes of the coder.
+                template <unsigned int K, typename Coder>
+                class Stepper
+                {
+
+                    private:
+
+                        const FixedPhi* phi;
+
+                        const Coder* coder;
+
+                        long long z[N][K];
+
+                        // The last loaded point, scans load consecutive codes, which are cheaper to step to than to decode
+                        long long cursor[N];
+
+                        unsigned long long cursorCode;
+
+                        unsigned long long cursorBoxCode;
+
+                    public:
+
+                        static const unsigned int lanes = K;
+
+                        Stepper(const FixedPhi& phi, const Coder& coder): phi(&phi), coder(&coder), cursorCode(0), cursorBoxCode(coder.toBox(0))
+                        {
+                            phi.decode(cursorBoxCode, cursor);
+                            for (unsigned int l = 0; l < K; ++l)
+                            {
+                                load(l, 0);
+                            }
+                        }
+
+                        void load(unsigned int lane, unsigned long long code)
+                        {
+                            if (code != cursorCode)
+                            {
+                                unsigned long long boxCode = coder->toBox(code);
+                                if (boxCode == cursorBoxCode + 1)
+                                {
+                                    phi->increment(cursor);
+                                }
+                                else
+                                {
+                                    phi->decode(boxCode, cursor);
+                                }
+                                cursorCode = code;
+                                cursorBoxCode = boxCode;
+                            }
+
+                            for (unsigned int j = 0; j < N; ++j)
+                            {
+                                z[j][lane] = cursor[j];
+                            }
+                        }
+
+                        void step(unsigned long long* codes, bool* valid)
+                        {
+                            phi->step(z, codes, valid);
+                            for (unsigned int l = 0; l < K; ++l)
+                            {
+                                codes[l] = coder->fromBox(codes[l], valid[l]);
+                            }
+                        }
+
+                };
+
+                template <
+                    template<typename> class VectorType,
+                    template<typename> class MatrixType
+                    >
+                FixedPhi(const RadixProperties<long long>& props, const SmithHash<long long, MatrixType>& smithHash,
+                         const std::vector<VectorType<long long>>& digitSet, const VectorCoder& coder);
+
+                // False if the digit set is not a complete residue system, i.e. phi is not well defined
+                bool isComplete() const;
+
+                void decode(unsigned long long code, long long (&z)[N]) const;
+
+                // Sets z to the point of the next code
+                void increment(long long (&z)[N]) const;
+
+                // Replaces every lane of z with its image under phi, and stores the codes of the images. valid[l] is set to
+                // false if the image in lane l is out of the bounds of the coder.
+                template <unsigned int K>
+                void step(long long (&z)[N][K], unsigned long long* codes, bool* valid) const;
+
+        };
+
+    }
+}
+
+// Include implementation
+#include "fixed_phi.hpp"
+
+#endif // GENUSYS_NUMSYS_FIXED_PHI_H_
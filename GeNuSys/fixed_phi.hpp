@@ -0,0 +1,436 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "element_traits.h"
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        template <
+            template<typename> class VectorType,
+            template<typename> class MatrixType
+            >
+        bool phiFitsLongLong(const RadixProperties<long long>& props, const SmithHash<long long, MatrixType>& smithHash,
+                             const std::vector<VectorType<long long>>& digitSet, const VectorCoder& coder)
+        {
+            const long long minValue = std::numeric_limits<long long>::min();
+            unsigned int n = props.getBase().getRows();
+            std::vector<long long> maxZ(n);
+            std::vector<long long> maxDiff(n);
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                maxZ[j] = std::max<long long>(-(long long) coder.getLowerBound()[j], coder.getUpperBound()[j]);
+                maxDiff[j] = maxZ[j];
+                for (unsigned int d = 0; d < digitSet.size(); ++d)
+                {
+                    long long diff;
+                    if (digitSet[d][j] == minValue || __builtin_add_overflow(maxZ[j], std::abs((long long) digitSet[d][j]), &diff))
+                    {
+                        return false;
+                    }
+                    maxDiff[j] = std::max(maxDiff[j], diff);
+                }
+            }
+
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                long long hashBound = 0;
+                long long phiBound = 0;
+                for (unsigned int j = 0; j < n; ++j)
+                {
+                    long long u = (i < smithHash.getSize()) ? smithHash.getU()(i, j) : 0;
+                    long long a = props.getAdjoint()(i, j);
+                    long long product;
+                    if (u == minValue || __builtin_mul_overflow(std::abs(u), maxZ[j], &product) || __builtin_add_overflow(hashBound, product, &hashBound) ||
+                        a == minValue || __builtin_mul_overflow(std::abs(a), maxDiff[j], &product) || __builtin_add_overflow(phiBound, product, &phiBound))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        template <unsigned int N>
+        template <
+            template<typename> class VectorType,
+            template<typename> class MatrixType
+            >
+        FixedPhi<N>::FixedPhi(const RadixProperties<long long>& props, const SmithHash<long long, MatrixType>& smithHash,
+                              const std::vector<VectorType<long long>>& digitSet, const VectorCoder& coder): lookup(smithHash, N, getLookupRange(coder))
+        {
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                adjCount[i] = 0;
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    if (props.getAdjoint()(i, j) != 0)
+                    {
+                        adjValue[i][adjCount[i]] = props.getAdjoint()(i, j);
+                        adjCol[i][adjCount[i]++] = j;
+                    }
+                    U[i][j] = (i < smithHash.getSize()) ? smithHash.getU()(i, j) : 0;
+                }
+                G[i] = Divider<long long>((i < smithHash.getSize()) ? smithHash.getG()[i] : 1);
+                prodG[i] = (i < smithHash.getSize()) ? smithHash.getProdG()[i] : 0;
+
+                lowerBound[i] = coder.getLowerBound()[i];
+                upperBound[i] = coder.getUpperBound()[i];
+                varBase[i] = upperBound[i] - lowerBound[i] + 1;
+                stride[i] = (i == 0) ? 1 : stride[i - 1] * varBase[i - 1];
+            }
+            det = props.getDetDivider();
+
+            // The hashes of the points are the |det| residue classes, every one of them needs exactly one digit
+            const unsigned long long residues = (unsigned long long) std::abs(det.getDivisor());
+            complete = (digitSet.size() == residues);
+            digits.resize(complete ? residues : 0);
+            std::vector<bool> filled(digits.size(), false);
+            long long digit[N];
+            for (unsigned int d = 0; d < digitSet.size() && complete; ++d)
+            {
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    digit[j] = digitSet[d][j];
+                }
+                unsigned long long h = hash(digit);
+                if (h >= digits.size() || filled[h])
+                {
+                    complete = false;
+                    continue;
+                }
+                filled[h] = true;
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    digits[h][j] = digit[j];
+                }
+            }
+            complete = complete && std::find(filled.begin(), filled.end(), false) == filled.end();
+
+            checked = !phiFitsLongLong(props, smithHash, digitSet, coder);
+        }
+
+        template <unsigned int N>
+        bool FixedPhi<N>::isComplete() const
+        {
+            return complete;
+        }
+
+        template <unsigned int N>
+        long long FixedPhi<N>::getLookupRange(const VectorCoder& coder)
+        {
+            long long range = 0;
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                range = std::max<long long>(range, std::max<long long>(-coder.getLowerBound()[i], coder.getUpperBound()[i]));
+            }
+
+            return std::min<long long>(range, GENUSYS_LOOKUP_HASH_RANGE);
+        }
+
+        template <unsigned int N>
+        unsigned long long FixedPhi<N>::hash(const long long (&z)[N]) const
+        {
+            long long sum = 0;
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                long long Uz = 0;
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    Uz += U[i][j] * z[j];
+                }
+                sum += G[i].mod(Uz) * prodG[i];
+            }
+
+            return (unsigned long long) sum;
+        }
+
+        template <unsigned int N>
+        bool FixedPhi<N>::stepChecked(long long (&z)[N]) const
+        {
+            long long sum = 0;
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                long long Uz = 0;
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    long long product;
+                    if (__builtin_mul_overflow(U[i][j], z[j], &product) || __builtin_add_overflow(Uz, product, &Uz))
+                    {
+                        return false;
+                    }
+                }
+                sum += G[i].mod(Uz) * prodG[i];
+            }
+
+            const std::array<long long, N>& digit = digits[sum];
+            long long diff[N];
+            for (unsigned int j = 0; j < N; ++j)
+            {
+                if (__builtin_sub_overflow(z[j], digit[j], &diff[j]))
+                {
+                    return false;
+                }
+            }
+
+            long long image[N];
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                long long adjDiff = 0;
+                for (unsigned int k = 0; k < adjCount[i]; ++k)
+                {
+                    long long product;
+                    if (__builtin_mul_overflow(adjValue[i][k], diff[adjCol[i][k]], &product) || __builtin_add_overflow(adjDiff, product, &adjDiff))
+                    {
+                        return false;
+                    }
+                }
+                image[i] = det.exactQuotient(adjDiff);
+            }
+
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                z[i] = image[i];
+            }
+            return true;
+        }
+
+        template <unsigned int N>
+        void FixedPhi<N>::stepExact(long long (&z)[N]) const
+        {
+            mpz_class exactZ[N];
+            for (unsigned int j = 0; j < N; ++j)
+            {
+                exactZ[j] = ElementTraits<long long>::asType<mpz_class>(z[j]);
+            }
+
+            unsigned long long sum = 0;
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                mpz_class Uz = 0;
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    Uz += ElementTraits<long long>::asType<mpz_class>(U[i][j]) * exactZ[j];
+                }
+                mpz_class residue = ElementTraits<mpz_class>::mod(Uz, ElementTraits<long long>::asType<mpz_class>(G[i].getDivisor()));
+                sum += residue.get_ui() * prodG[i];
+            }
+
+            const std::array<long long, N>& digit = digits[sum];
+            mpz_class diff[N];
+            for (unsigned int j = 0; j < N; ++j)
+            {
+                diff[j] = exactZ[j] - ElementTraits<long long>::asType<mpz_class>(digit[j]);
+            }
+
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                mpz_class adjDiff = 0;
+                for (unsigned int k = 0; k < adjCount[i]; ++k)
+                {
+                    adjDiff += ElementTraits<long long>::asType<mpz_class>(adjValue[i][k]) * diff[adjCol[i][k]];
+                }
+                mpz_class image = ElementTraits<mpz_class>::idiv(adjDiff, ElementTraits<long long>::asType<mpz_class>(det.getDivisor()));
+                if (image < (long) lowerBound[i])
+                {
+                    z[i] = lowerBound[i] - 1;
+                }
+                else if (image > (long) upperBound[i])
+                {
+                    z[i] = upperBound[i] + 1;
+                }
+                else
+                {
+                    z[i] = image.get_si();
+                }
+            }
+        }
+
+        template <unsigned int N>
+        void FixedPhi<N>::decode(unsigned long long code, long long (&z)[N]) const
+        {
+            for (unsigned int j = 0; j < N; ++j)
+            {
+                z[j] = (long long) (code % varBase[j]) + lowerBound[j];
+                code /= varBase[j];
+            }
+        }
+
+        template <unsigned int N>
+        void FixedPhi<N>::increment(long long (&z)[N]) const
+        {
+            for (unsigned int j = 0; j < N; ++j)
+            {
+                if (z[j] < upperBound[j])
+                {
+                    ++z[j];
+                    return;
+                }
+                z[j] = lowerBound[j];
+            }
+        }
+
+        template <unsigned int N>
+        template <unsigned int K>
+        void FixedPhi<N>::step(long long (&z)[N][K], unsigned long long* codes, bool* valid) const
+        {
+            if (checked)
+            {
+                for (unsigned int l = 0; l < K; ++l)
+                {
+                    long long point[N];
+                    for (unsigned int j = 0; j < N; ++j)
+                    {
+                        point[j] = z[j][l];
+                    }
+                    if (!stepChecked(point))
+                    {
+                        stepExact(point);
+                    }
+                    for (unsigned int j = 0; j < N; ++j)
+                    {
+                        z[j][l] = point[j];
+                    }
+                }
+                encode(z, codes, valid);
+                return;
+            }
+
+            unsigned long long h[K];
+            if (lookup.isEnabled())
+            {
+                long long range = lookup.getRange();
+                for (unsigned int l = 0; l < K; ++l)
+                {
+                    unsigned int packed = 0;
+                    bool inside = true;
+                    for (unsigned int j = 0; j < N; ++j)
+                    {
+                        inside &= ((unsigned long long) (z[j][l] + range) <= (unsigned long long) (2 * range));
+                    }
+                    if (inside)
+                    {
+                        for (unsigned int j = 0; j < N; ++j)
+                        {
+                            packed += lookup.get(j, z[j][l]);
+                        }
+                        h[l] = lookup.reduce(packed);
+                    }
+                    else
+                    {
+                        long long point[N];
+                        for (unsigned int j = 0; j < N; ++j)
+                        {
+                            point[j] = z[j][l];
+                        }
+                        h[l] = hash(point);
+                    }
+                }
+            }
+            else
+            {
+                for (unsigned int l = 0; l < K; ++l)
+                {
+                    h[l] = 0;
+                }
+                for (unsigned int i = 0; i < N; ++i)
+                {
+                    long long Uz[K];
+                    for (unsigned int l = 0; l < K; ++l)
+                    {
+                        Uz[l] = 0;
+                    }
+                    for (unsigned int j = 0; j < N; ++j)
+                    {
+                        for (unsigned int l = 0; l < K; ++l)
+                        {
+                            Uz[l] += U[i][j] * z[j][l];
+                        }
+                    }
+                    for (unsigned int l = 0; l < K; ++l)
+                    {
+                        h[l] += G[i].mod(Uz[l]) * prodG[i];
+                    }
+                }
+            }
+
+            long long diff[N][K];
+            for (unsigned int l = 0; l < K; ++l)
+            {
+                const std::array<long long, N>& digit = digits[h[l]];
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    diff[j][l] = z[j][l] - digit[j];
+                }
+            }
+
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                long long sum[K];
+                for (unsigned int l = 0; l < K; ++l)
+                {
+                    sum[l] = 0;
+                }
+                for (unsigned int k = 0; k < adjCount[i]; ++k)
+                {
+                    for (unsigned int l = 0; l < K; ++l)
+                    {
+                        sum[l] += adjValue[i][k] * diff[adjCol[i][k]][l];
+                    }
+                }
+                for (unsigned int l = 0; l < K; ++l)
+                {
+                    z[i][l] = det.exactQuotient(sum[l]);
+                }
+            }
+
+            encode(z, codes, valid);
+        }
+
+        template <unsigned int N>
+        template <unsigned int K>
+        void FixedPhi<N>::encode(const long long (&z)[N][K], unsigned long long* codes, bool* valid) const
+        {
+            // Branch free encoding, a coordinate below its lower bound wraps around to a huge offset
+            bool inside[K];
+            for (unsigned int l = 0; l < K; ++l)
+            {
+                inside[l] = true;
+                codes[l] = 0;
+            }
+            for (unsigned int j = 0; j < N; ++j)
+            {
+                for (unsigned int l = 0; l < K; ++l)
+                {
+                    unsigned long long offset = (unsigned long long) (z[j][l] - lowerBound[j]);
+                    inside[l] &= (offset < varBase[j]);
+                    codes[l] += offset * stride[j];
+                }
+            }
+            for (unsigned int l = 0; l < K; ++l)
+            {
+                valid[l] = inside[l];
+            }
+        }
+
+    }
+}
@@ -22,7 +22,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <vector>
 
+#include "matrix.h"
 #include "smith_hash.h"
+#include "lookup_hash.h"
 
 namespace GeNuSys
 {
@@ -41,14 +43,61 @@ namespace GeNuSys
 
                 SmithHash<ElementType, MatrixType> hash;
 
+                // Used instead of hash if the Smith invariants are small enough
+                LookupHash lookup;
+
                 std::vector<VectorType<ElementType>> digitSet;
 
                 std::vector<VectorType<ElementType>> hashTable;
 
+                unsigned int length;
+
+                // False if the digit set is not a complete residue system, see isComplete
+                bool complete;
+
+                // Row major matrices of the digits and of adjoint * digit, indexed by the hash of the digit
+                std::vector<ElementType> digitRows;
+
+                std::vector<ElementType> adjointDigitRows;
+
+                void init(const GeNuSys::LinAlg::Matrix<ElementType>* adjoint);
+
             public:
 
                 HashTable(const SmithHash<ElementType, MatrixType>& hash, const std::vector<VectorType<ElementType>>& digitSet);
 
+                // Also stores adjoint * digit for every digit, see getAdjointDigitRow
+                HashTable(const SmithHash<ElementType, MatrixType>& hash, const std::vector<VectorType<ElementType>>& digitSet, const GeNuSys::LinAlg::Matrix<ElementType>& adjoint);
+
+                // True if every residue class has exactly one digit, i.e. phi is well defined. Otherwise the first of the
+                // congruent digits is kept, and index throws for the residues without a digit.
+                bool isComplete() const;
+
+                // The index of the digit congruent to z
+                unsigned long long index(const GeNuSys::LinAlg::Vector<ElementType>& z, GeNuSys::LinAlg::Vector<ElementType>& Uz) const;
+
+                // True if a digit has the hash idx
+                bool hasDigit(unsigned long long idx) const
+                {
+                    return idx < hashTable.size() && hashTable[idx].getLength() == length;
+                }
+
+                const VectorType<ElementType>& getDigit(unsigned long long idx) const
+                {
+                    return hashTable[idx];
+                }
+
+                const ElementType* getDigitRow(unsigned long long idx) const
+                {
+                    return &digitRows[idx * length];
+                }
+
+                // Only available if the table was built with the adjoint
+                const ElementType* getAdjointDigitRow(unsigned long long idx) const
+                {
+                    return &adjointDigitRows[idx * length];
+                }
+
                 const VectorType<ElementType>& operator()(const GeNuSys::LinAlg::Vector<ElementType>& z) const;
 
                 const VectorType<ElementType>& operator()(const GeNuSys::LinAlg::Vector<ElementType>& z, GeNuSys::LinAlg::Vector<ElementType>& Uz) const;
@@ -17,6 +17,8 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <stdexcept>
+
 namespace GeNuSys
 {
     namespace NumSys
@@ -27,15 +29,110 @@ namespace GeNuSys
             template<typename> class VectorType,
             template<typename> class MatrixType
             >
-        HashTable<ElementType, VectorType, MatrixType>::HashTable(const SmithHash<ElementType, MatrixType>& hash, const std::vector<VectorType<ElementType>>& digitSet): hash(hash), digitSet(digitSet)
+        HashTable<ElementType, VectorType, MatrixType>::HashTable(const SmithHash<ElementType, MatrixType>& hash, const std::vector<VectorType<ElementType>>& digitSet): hash(hash),
+            lookup(hash, hash.getU().getCols()), digitSet(digitSet)
         {
-            // TODO: VERIFY CRS PROPERTY!!!
-            hashTable = std::vector<VectorType<ElementType>>(digitSet.size());
+            init(0);
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType
+            >
+        HashTable<ElementType, VectorType, MatrixType>::HashTable(const SmithHash<ElementType, MatrixType>& hash, const std::vector<VectorType<ElementType>>& digitSet,
+                                                                  const GeNuSys::LinAlg::Matrix<ElementType>& adjoint): hash(hash), lookup(hash, hash.getU().getCols()), digitSet(digitSet)
+        {
+            init(&adjoint);
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType
+            >
+        void HashTable<ElementType, VectorType, MatrixType>::init(const GeNuSys::LinAlg::Matrix<ElementType>* adjoint)
+        {
+            length = hash.getU().getCols();
+
+            // One slot for each of the prod(G) = |det| residue classes
+            ElementType residues = ElementTraits<ElementType>::one();
+            for (unsigned int i = 0; i < hash.getSize(); ++i)
+            {
+                residues *= hash.getG()[i];
+            }
+            unsigned long int size = ElementTraits<ElementType>::template asTypeUnsafe<unsigned long int>(residues);
+            complete = true;
+            hashTable = std::vector<VectorType<ElementType>>(size);
+            digitRows.assign(size * length, ElementTraits<ElementType>::zero());
+            if (adjoint)
+            {
+                adjointDigitRows.assign(size * length, ElementTraits<ElementType>::zero());
+            }
+
             GeNuSys::LinAlg::Vector<ElementType> Uz = hash.createCache();
             for (unsigned int i = 0; i < digitSet.size(); ++i)
             {
-                hashTable[ElementTraits<ElementType>::template asTypeUnsafe<unsigned long int>(hash(digitSet[i], Uz))] = digitSet[i];
+                // A digit congruent to an earlier one is dropped
+                unsigned long int idx = ElementTraits<ElementType>::template asTypeUnsafe<unsigned long int>(hash(digitSet[i], Uz));
+                if (hasDigit(idx))
+                {
+                    complete = false;
+                    continue;
+                }
+                hashTable[idx] = digitSet[i];
+
+                GeNuSys::LinAlg::Vector<ElementType> digit(length);
+                digit = digitSet[i];
+                for (unsigned int j = 0; j < length; ++j)
+                {
+                    digitRows[idx * length + j] = digit[j];
+                }
+                if (adjoint)
+                {
+                    GeNuSys::LinAlg::Vector<ElementType> adjointDigit = (*adjoint) * digit;
+                    for (unsigned int j = 0; j < length; ++j)
+                    {
+                        adjointDigitRows[idx * length + j] = adjointDigit[j];
+                    }
+                }
             }
+
+            // The residues without a digit are reported by index
+            for (unsigned long int idx = 0; idx < size && complete; ++idx)
+            {
+                complete = hasDigit(idx);
+            }
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType
+            >
+        bool HashTable<ElementType, VectorType, MatrixType>::isComplete() const
+        {
+            return complete;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType
+            >
+        unsigned long long HashTable<ElementType, VectorType, MatrixType>::index(const GeNuSys::LinAlg::Vector<ElementType>& z, GeNuSys::LinAlg::Vector<ElementType>& Uz) const
+        {
+            unsigned long long h;
+            if (!lookup.isEnabled() || !lookup(z, h))
+            {
+                h = ElementTraits<ElementType>::template asTypeUnsafe<unsigned long int>(hash(z, Uz));
+            }
+            if (!hasDigit(h))
+            {
+                throw std::logic_error{"No digit is congruent to the point, the digit set is not a complete residue system"};
+            }
+
+            return h;
         }
 
         template <
@@ -45,7 +142,8 @@ namespace GeNuSys
             >
         const VectorType<ElementType>& HashTable<ElementType, VectorType, MatrixType>::operator()(const GeNuSys::LinAlg::Vector<ElementType>& z) const
         {
-            return hashTable[hash(z, hash.createCache())];
+            GeNuSys::LinAlg::Vector<ElementType> Uz = hash.createCache();
+            return hashTable[index(z, Uz)];
         }
 
         template <
@@ -55,7 +153,7 @@ namespace GeNuSys
             >
         const VectorType<ElementType>& HashTable<ElementType, VectorType, MatrixType>::operator()(const GeNuSys::LinAlg::Vector<ElementType>& z, GeNuSys::LinAlg::Vector<ElementType>& Uz) const
         {
-            return hashTable[ElementTraits<ElementType>::template asTypeUnsafe<unsigned long int>(hash(z, Uz))];
+            return hashTable[index(z, Uz)];
         }
 
     }
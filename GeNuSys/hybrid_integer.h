@@ -0,0 +1,143 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GENUSYS_HYBRID_INTEGER_H_
+#define GENUSYS_HYBRID_INTEGER_H_
+
+#include <ostream>
+
+#include <gmp.h>
+#include <gmpxx.h>
+
+namespace GeNuSys
+{
+
+    // An arbitrary precision integer which is stored inline while it fits into a long long, and spills into a heap
+    // allocated mpz_class only when an operation overflows. The overflows are detected by the __builtin_*_overflow
+    // functions, so values of typical bases never touch GMP.
+    class HybridInteger
+    {
+
+        private:
+
+            long long small;
+
+            // Null while the value fits into small
+            mpz_class* big;
+
+            void assign(const mpz_class& value);
+
+            // Moves the value into big if it is small, and returns big
+            mpz_class& spill();
+
+            // Moves the value of big back into small if it fits
+            void shrink();
+
+            // The mpz_*_ui and mpz_*_si functions take a long, which is narrower than long long on some platforms
+            static bool fitsLong(long long value);
+
+            // |value| as the argument of the mpz_*_ui functions, only for values for which fitsLong is true
+            static unsigned long magnitude(long long value);
+
+        public:
+
+            HybridInteger();
+
+            HybridInteger(int value);
+
+            HybridInteger(long value);
+
+            HybridInteger(long long value);
+
+            explicit HybridInteger(const mpz_class& value);
+
+            HybridInteger(const HybridInteger& other);
+
+            HybridInteger(HybridInteger&& other);
+
+            ~HybridInteger();
+
+            HybridInteger& operator=(const HybridInteger& other);
+
+            HybridInteger& operator=(HybridInteger&& other);
+
+            bool isSmall() const;
+
+            // The value if isSmall()
+            long long getSmall() const;
+
+            // The value if !isSmall()
+            const mpz_class& getBig() const;
+
+            mpz_class toMpz() const;
+
+            double toDouble() const;
+
+            // -1, 0 or 1
+            int sign() const;
+
+            HybridInteger operator-() const;
+
+            // Work on big in place, the small operand of a mixed operation is passed to GMP without converting it to mpz_class
+            HybridInteger& operator+=(const HybridInteger& other);
+
+            HybridInteger& operator-=(const HybridInteger& other);
+
+            HybridInteger& operator*=(const HybridInteger& other);
+
+            // Truncating division and remainder, like the operators of long long and mpz_class
+            HybridInteger& operator/=(const HybridInteger& other);
+
+            HybridInteger& operator%=(const HybridInteger& other);
+
+    };
+
+    HybridInteger operator+(const HybridInteger& a, const HybridInteger& b);
+
+    HybridInteger operator-(const HybridInteger& a, const HybridInteger& b);
+
+    HybridInteger operator*(const HybridInteger& a, const HybridInteger& b);
+
+    HybridInteger operator/(const HybridInteger& a, const HybridInteger& b);
+
+    HybridInteger operator%(const HybridInteger& a, const HybridInteger& b);
+
+    // Negative, zero or positive if a < b, a == b or a > b
+    int compare(const HybridInteger& a, const HybridInteger& b);
+
+    bool operator==(const HybridInteger& a, const HybridInteger& b);
+
+    bool operator!=(const HybridInteger& a, const HybridInteger& b);
+
+    bool operator<(const HybridInteger& a, const HybridInteger& b);
+
+    bool operator>(const HybridInteger& a, const HybridInteger& b);
+
+    bool operator<=(const HybridInteger& a, const HybridInteger& b);
+
+    bool operator>=(const HybridInteger& a, const HybridInteger& b);
+
+    std::ostream& operator<<(std::ostream& os, const HybridInteger& value);
+
+}
+
+// Include implementation
+#include "hybrid_integer.hpp"
+
+#endif // GENUSYS_HYBRID_INTEGER_H_
@@ -0,0 +1,467 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <limits>
+#include <string>
+
+namespace GeNuSys
+{
+
+    inline HybridInteger::HybridInteger(): small(0), big(nullptr)
+    {
+    }
+
+    inline HybridInteger::HybridInteger(int value): small(value), big(nullptr)
+    {
+    }
+
+    inline HybridInteger::HybridInteger(long value): small(value), big(nullptr)
+    {
+    }
+
+    inline HybridInteger::HybridInteger(long long value): small(value), big(nullptr)
+    {
+    }
+
+    inline HybridInteger::HybridInteger(const mpz_class& value): small(0), big(nullptr)
+    {
+        assign(value);
+    }
+
+    inline HybridInteger::HybridInteger(const HybridInteger& other): small(other.small), big(other.big ? new mpz_class(*other.big) : nullptr)
+    {
+    }
+
+    inline HybridInteger::HybridInteger(HybridInteger&& other): small(other.small), big(other.big)
+    {
+        other.big = nullptr;
+    }
+
+    inline HybridInteger::~HybridInteger()
+    {
+        delete big;
+    }
+
+    inline HybridInteger& HybridInteger::operator=(const HybridInteger& other)
+    {
+        if (this != &other)
+        {
+            small = other.small;
+            if (other.big)
+            {
+                assign(*other.big);
+            }
+            else
+            {
+                delete big;
+                big = nullptr;
+            }
+        }
+
+        return *this;
+    }
+
+    inline HybridInteger& HybridInteger::operator=(HybridInteger&& other)
+    {
+        if (this != &other)
+        {
+            delete big;
+            small = other.small;
+            big = other.big;
+            other.big = nullptr;
+        }
+
+        return *this;
+    }
+
+    inline void HybridInteger::assign(const mpz_class& value)
+    {
+        // long is 64 bits wide on the usual unix platforms, elsewhere medium values simply stay in GMP
+        if (sizeof(long) >= sizeof(long long) && value.fits_slong_p())
+        {
+            small = value.get_si();
+            delete big;
+            big = nullptr;
+        }
+        else if (big)
+        {
+            *big = value;
+        }
+        else
+        {
+            big = new mpz_class(value);
+        }
+    }
+
+    inline bool HybridInteger::isSmall() const
+    {
+        return big == nullptr;
+    }
+
+    inline long long HybridInteger::getSmall() const
+    {
+        return small;
+    }
+
+    inline const mpz_class& HybridInteger::getBig() const
+    {
+        return *big;
+    }
+
+    inline mpz_class HybridInteger::toMpz() const
+    {
+        if (big)
+        {
+            return *big;
+        }
+        if (sizeof(long) >= sizeof(long long))
+        {
+            return mpz_class((long) small);
+        }
+
+        return mpz_class(std::to_string(small));
+    }
+
+    inline double HybridInteger::toDouble() const
+    {
+        return big ? big->get_d() : (double) small;
+    }
+
+    inline int HybridInteger::sign() const
+    {
+        if (big)
+        {
+            return sgn(*big);
+        }
+
+        return (small > 0) - (small < 0);
+    }
+
+    inline HybridInteger HybridInteger::operator-() const
+    {
+        if (!big && small != std::numeric_limits<long long>::min())
+        {
+            return HybridInteger(-small);
+        }
+
+        HybridInteger result(*this);
+        mpz_class& value = result.spill();
+        mpz_neg(value.get_mpz_t(), value.get_mpz_t());
+        result.shrink();
+
+        return result;
+    }
+
+    inline HybridInteger& HybridInteger::operator+=(const HybridInteger& other)
+    {
+        long long result;
+        if (!big && !other.big && !__builtin_add_overflow(small, other.small, &result))
+        {
+            small = result;
+            return *this;
+        }
+
+        mpz_class& value = spill();
+        if (other.big)
+        {
+            mpz_add(value.get_mpz_t(), value.get_mpz_t(), other.big->get_mpz_t());
+        }
+        else if (fitsLong(other.small))
+        {
+            if (other.small >= 0)
+            {
+                mpz_add_ui(value.get_mpz_t(), value.get_mpz_t(), (unsigned long) other.small);
+            }
+            else
+            {
+                mpz_sub_ui(value.get_mpz_t(), value.get_mpz_t(), magnitude(other.small));
+            }
+        }
+        else
+        {
+            value += other.toMpz();
+        }
+        shrink();
+
+        return *this;
+    }
+
+    inline HybridInteger& HybridInteger::operator-=(const HybridInteger& other)
+    {
+        long long result;
+        if (!big && !other.big && !__builtin_sub_overflow(small, other.small, &result))
+        {
+            small = result;
+            return *this;
+        }
+
+        mpz_class& value = spill();
+        if (other.big)
+        {
+            mpz_sub(value.get_mpz_t(), value.get_mpz_t(), other.big->get_mpz_t());
+        }
+        else if (fitsLong(other.small))
+        {
+            if (other.small >= 0)
+            {
+                mpz_sub_ui(value.get_mpz_t(), value.get_mpz_t(), (unsigned long) other.small);
+            }
+            else
+            {
+                mpz_add_ui(value.get_mpz_t(), value.get_mpz_t(), magnitude(other.small));
+            }
+        }
+        else
+        {
+            value -= other.toMpz();
+        }
+        shrink();
+
+        return *this;
+    }
+
+    inline HybridInteger& HybridInteger::operator*=(const HybridInteger& other)
+    {
+        long long result;
+        if (!big && !other.big && !__builtin_mul_overflow(small, other.small, &result))
+        {
+            small = result;
+            return *this;
+        }
+
+        mpz_class& value = spill();
+        if (other.big)
+        {
+            mpz_mul(value.get_mpz_t(), value.get_mpz_t(), other.big->get_mpz_t());
+        }
+        else if (fitsLong(other.small))
+        {
+            mpz_mul_si(value.get_mpz_t(), value.get_mpz_t(), (long) other.small);
+        }
+        else
+        {
+            value *= other.toMpz();
+        }
+        shrink();
+
+        return *this;
+    }
+
+    inline HybridInteger& HybridInteger::operator/=(const HybridInteger& other)
+    {
+        // The only quotient of two long longs which overflows is LLONG_MIN / -1
+        if (!big && !other.big && (other.small != -1 || small != std::numeric_limits<long long>::min()))
+        {
+            small /= other.small;
+            return *this;
+        }
+
+        mpz_class& value = spill();
+        if (other.big)
+        {
+            mpz_tdiv_q(value.get_mpz_t(), value.get_mpz_t(), other.big->get_mpz_t());
+        }
+        else if (fitsLong(other.small))
+        {
+            mpz_tdiv_q_ui(value.get_mpz_t(), value.get_mpz_t(), magnitude(other.small));
+            if (other.small < 0)
+            {
+                mpz_neg(value.get_mpz_t(), value.get_mpz_t());
+            }
+        }
+        else
+        {
+            value /= other.toMpz();
+        }
+        shrink();
+
+        return *this;
+    }
+
+    inline HybridInteger& HybridInteger::operator%=(const HybridInteger& other)
+    {
+        if (!big && !other.big)
+        {
+            small = (other.small == -1) ? 0 : small % other.small;
+            return *this;
+        }
+
+        // The remainder by a long long fits into long long and has the sign of the dividend
+        if (big && !other.big && fitsLong(other.small))
+        {
+            long long remainder = (long long) mpz_tdiv_ui(big->get_mpz_t(), magnitude(other.small));
+            small = (sgn(*big) < 0) ? -remainder : remainder;
+            delete big;
+            big = nullptr;
+            return *this;
+        }
+
+        mpz_class& value = spill();
+        if (other.big)
+        {
+            mpz_tdiv_r(value.get_mpz_t(), value.get_mpz_t(), other.big->get_mpz_t());
+        }
+        else
+        {
+            value %= other.toMpz();
+        }
+        shrink();
+
+        return *this;
+    }
+
+    inline mpz_class& HybridInteger::spill()
+    {
+        if (!big)
+        {
+            big = new mpz_class(toMpz());
+        }
+
+        return *big;
+    }
+
+    inline void HybridInteger::shrink()
+    {
+        if (sizeof(long) >= sizeof(long long) && big->fits_slong_p())
+        {
+            small = big->get_si();
+            delete big;
+            big = nullptr;
+        }
+    }
+
+    inline bool HybridInteger::fitsLong(long long value)
+    {
+        return value >= std::numeric_limits<long>::min() && value <= std::numeric_limits<long>::max();
+    }
+
+    inline unsigned long HybridInteger::magnitude(long long value)
+    {
+        return (value < 0) ? 0UL - (unsigned long) value : (unsigned long) value;
+    }
+
+    inline HybridInteger operator+(const HybridInteger& a, const HybridInteger& b)
+    {
+        HybridInteger result(a);
+        result += b;
+
+        return result;
+    }
+
+    inline HybridInteger operator-(const HybridInteger& a, const HybridInteger& b)
+    {
+        HybridInteger result(a);
+        result -= b;
+
+        return result;
+    }
+
+    inline HybridInteger operator*(const HybridInteger& a, const HybridInteger& b)
+    {
+        HybridInteger result(a);
+        result *= b;
+
+        return result;
+    }
+
+    inline HybridInteger operator/(const HybridInteger& a, const HybridInteger& b)
+    {
+        HybridInteger result(a);
+        result /= b;
+
+        return result;
+    }
+
+    inline HybridInteger operator%(const HybridInteger& a, const HybridInteger& b)
+    {
+        HybridInteger result(a);
+        result %= b;
+
+        return result;
+    }
+
+    inline int compare(const HybridInteger& a, const HybridInteger& b)
+    {
+        if (a.isSmall() && b.isSmall())
+        {
+            return (a.getSmall() > b.getSmall()) - (a.getSmall() < b.getSmall());
+        }
+        if (!a.isSmall() && !b.isSmall())
+        {
+            return cmp(a.getBig(), b.getBig());
+        }
+
+        // One of them is big, the other one is compared without converting it to mpz_class if it fits into long
+        const HybridInteger& bigValue = a.isSmall() ? b : a;
+        const long long smallValue = a.isSmall() ? a.getSmall() : b.getSmall();
+        int result;
+        if (smallValue >= std::numeric_limits<long>::min() && smallValue <= std::numeric_limits<long>::max())
+        {
+            result = mpz_cmp_si(bigValue.getBig().get_mpz_t(), (long) smallValue);
+        }
+        else
+        {
+            result = cmp(bigValue.getBig(), HybridInteger(smallValue).toMpz());
+        }
+        result = (result > 0) - (result < 0);
+
+        return a.isSmall() ? -result : result;
+    }
+
+    inline bool operator==(const HybridInteger& a, const HybridInteger& b)
+    {
+        return compare(a, b) == 0;
+    }
+
+    inline bool operator!=(const HybridInteger& a, const HybridInteger& b)
+    {
+        return compare(a, b) != 0;
+    }
+
+    inline bool operator<(const HybridInteger& a, const HybridInteger& b)
+    {
+        return compare(a, b) < 0;
+    }
+
+    inline bool operator>(const HybridInteger& a, const HybridInteger& b)
+    {
+        return compare(a, b) > 0;
+    }
+
+    inline bool operator<=(const HybridInteger& a, const HybridInteger& b)
+    {
+        return compare(a, b) <= 0;
+    }
+
+    inline bool operator>=(const HybridInteger& a, const HybridInteger& b)
+    {
+        return compare(a, b) >= 0;
+    }
+
+    inline std::ostream& operator<<(std::ostream& os, const HybridInteger& value)
+    {
+        if (value.isSmall())
+        {
+            return os << value.getSmall();
+        }
+
+        return os << value.toMpz();
+    }
+
+}
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define GENUSYS_LINALG_LINALG_ALGORITHMS_H_
 
 #include <vector>
+#include <type_traits>
 
 #include "element_traits.h"
 
@@ -169,6 +170,56 @@ namespace GeNuSys
             template<typename ElementType>
             static JordanForm<ElementType> getJordanForm(const Matrix<ElementType>& mat);
 
+            // Fraction-free (Bareiss) elimination: every division is exact, so integer matrices never leave their
+            // FractionFreeType. det, invert, getAdjoint and getRank use these for integral element types.
+            template<typename ElementType>
+            static ElementType detBareiss(const Matrix<ElementType>& mat);
+
+            // Computes the adjoint and the determinant by fraction-free Gauss-Jordan elimination, returns false if mat is singular
+            template<typename ElementType>
+            static bool getAdjointBareiss(const Matrix<ElementType>& mat, Matrix<ElementType>& adj, ElementType& det);
+
+            template<typename ElementType>
+            static unsigned int getRankBareiss(const Matrix<ElementType>& mat);
+
+            // LLL reduction of the rows of an integer basis for the inner product x * gram * y^T, the result spans the
+            // same lattice. With deepInsertions a row is inserted before every earlier row it is shorter than after
+            // projection, not only swapped with its predecessor. Returns false and leaves basis unchanged if the reduction
+            // takes more than maxIterations steps or the floating point Gram-Schmidt coefficients degenerate.
+            template<typename ElementType>
+            static bool reduceLLL(Matrix<ElementType>& basis, const Matrix<double>& gram, bool deepInsertions = false, double delta = 0.99,
+                                  unsigned long long maxIterations = 100000);
+
+            // Selects the fraction-free or the rational version of det, invert, getAdjoint and getRank
+            template<typename ElementType>
+            static typename ElementTraits<ElementType>::RationalType det(const Matrix<ElementType>& mat, std::true_type);
+
+            template<typename ElementType>
+            static typename ElementTraits<ElementType>::RationalType det(const Matrix<ElementType>& mat, std::false_type);
+
+            template<typename ElementType>
+            static Matrix<typename ElementTraits<ElementType>::RationalType> invert(const Matrix<ElementType>& mat, std::true_type);
+
+            template<typename ElementType>
+            static Matrix<typename ElementTraits<ElementType>::RationalType> invert(const Matrix<ElementType>& mat, std::false_type);
+
+            template<typename ElementType>
+            static Matrix<ElementType> getAdjoint(const Matrix<ElementType>& mat, std::true_type);
+
+            template<typename ElementType>
+            static Matrix<ElementType> getAdjoint(const Matrix<ElementType>& mat, std::false_type);
+
+            template<typename ElementType>
+            static unsigned int getRank(const Matrix<ElementType>& mat, std::true_type);
+
+            template<typename ElementType>
+            static unsigned int getRank(const Matrix<ElementType>& mat, std::false_type);
+
+            template<typename ElementType>
+            struct IsFractionFree : std::integral_constant<bool, !std::is_void<typename FractionFreeType<ElementType>::Type>::value>
+            {
+            };
+
         };
 
     }
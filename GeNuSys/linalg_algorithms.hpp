@@ -18,6 +18,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <algorithm>
+#include <cmath>
 
 #include "linalg_traits.h"
 
@@ -73,6 +74,262 @@ namespace GeNuSys
 
         template<typename ElementType>
         typename ElementTraits<ElementType>::RationalType Algorithms::det(const Matrix<ElementType>& mat)
+        {
+            return Algorithms::det(mat, IsFractionFree<ElementType>());
+        }
+
+        template<typename ElementType>
+        typename ElementTraits<ElementType>::RationalType Algorithms::det(const Matrix<ElementType>& mat, std::true_type)
+        {
+            ASSERT_EXCEPTION(mat.cols == mat.rows, std::length_error);
+
+            typedef typename ElementTraits<ElementType>::RationalType RationalType;
+            typedef typename FractionFreeType<ElementType>::Type FractionFreeElementType;
+
+            return ElementTraits<FractionFreeElementType>::template asType<RationalType>(Algorithms::detBareiss(Matrix<FractionFreeElementType>(mat)));
+        }
+
+        template<typename ElementType>
+        Matrix<typename ElementTraits<ElementType>::RationalType> Algorithms::invert(const Matrix<ElementType>& mat)
+        {
+            return Algorithms::invert(mat, IsFractionFree<ElementType>());
+        }
+
+        template<typename ElementType>
+        Matrix<typename ElementTraits<ElementType>::RationalType> Algorithms::invert(const Matrix<ElementType>& mat, std::true_type)
+        {
+            ASSERT_EXCEPTION(mat.cols == mat.rows, std::length_error);
+
+            typedef typename ElementTraits<ElementType>::RationalType RationalType;
+            typedef typename FractionFreeType<ElementType>::Type FractionFreeElementType;
+
+            Matrix<FractionFreeElementType> adj;
+            FractionFreeElementType d;
+            if (!Algorithms::getAdjointBareiss(Matrix<FractionFreeElementType>(mat), adj, d))
+            {
+                return Algorithms::invert(mat, std::false_type());
+            }
+
+            const RationalType rationalDet = ElementTraits<FractionFreeElementType>::template asType<RationalType>(d);
+            Matrix<RationalType> inv(adj.rows, adj.cols);
+            for (unsigned int i = 0; i < adj.size(); ++i)
+            {
+                inv.elem[i] = ElementTraits<FractionFreeElementType>::template asType<RationalType>(adj.elem[i]) / rationalDet;
+            }
+
+            return inv;
+        }
+
+        template<typename ElementType>
+        Matrix<ElementType> Algorithms::getAdjoint(const Matrix<ElementType>& mat)
+        {
+            return Algorithms::getAdjoint(mat, IsFractionFree<ElementType>());
+        }
+
+        template<typename ElementType>
+        Matrix<ElementType> Algorithms::getAdjoint(const Matrix<ElementType>& mat, std::true_type)
+        {
+            ASSERT_EXCEPTION(mat.cols == mat.rows, std::length_error);
+
+            typedef typename FractionFreeType<ElementType>::Type FractionFreeElementType;
+
+            Matrix<FractionFreeElementType> adj;
+            FractionFreeElementType d;
+            if (!Algorithms::getAdjointBareiss(Matrix<FractionFreeElementType>(mat), adj, d))
+            {
+                return Algorithms::getAdjoint(mat, std::false_type());
+            }
+
+            Matrix<ElementType> result(adj.rows, adj.cols);
+            for (unsigned int i = 0; i < adj.size(); ++i)
+            {
+                result.elem[i] = ElementTraits<FractionFreeElementType>::template asTypeUnsafe<ElementType>(adj.elem[i]);
+            }
+
+            return result;
+        }
+
+        template<typename ElementType>
+        unsigned int Algorithms::getRank(const Matrix<ElementType>& mat)
+        {
+            return Algorithms::getRank(mat, IsFractionFree<ElementType>());
+        }
+
+        template<typename ElementType>
+        unsigned int Algorithms::getRank(const Matrix<ElementType>& mat, std::true_type)
+        {
+            typedef typename FractionFreeType<ElementType>::Type FractionFreeElementType;
+
+            return Algorithms::getRankBareiss(Matrix<FractionFreeElementType>(mat));
+        }
+
+        template<typename ElementType>
+        ElementType Algorithms::detBareiss(const Matrix<ElementType>& mat)
+        {
+            ASSERT_EXCEPTION(mat.cols == mat.rows, std::length_error);
+
+            const unsigned int N = mat.rows;
+
+            Matrix<ElementType> A = mat;
+            ElementType previous = ElementTraits<ElementType>::one();
+            bool negate = false;
+
+            for (unsigned int k = 0, idxPivot = 0; k < N; ++k, idxPivot += N + 1)
+            {
+                unsigned int pivotRow = k;
+                unsigned int idxA = idxPivot;
+                while (pivotRow < N && A.elem[idxA] == ElementTraits<ElementType>::zero())
+                {
+                    ++pivotRow;
+                    idxA += N;
+                }
+                if (pivotRow == N)
+                {
+                    return ElementTraits<ElementType>::zero();
+                }
+                if (pivotRow != k)
+                {
+                    for (unsigned int j = k, idxP = idxPivot, idxE = idxA; j < N; ++j, ++idxP, ++idxE)
+                    {
+                        std::swap(A.elem[idxP], A.elem[idxE]);
+                    }
+                    negate = !negate;
+                }
+
+                // Every entry of the eliminated rows becomes a (k + 2) x (k + 2) minor of mat, so the division is exact
+                for (unsigned int i = k + 1, idxERow = idxPivot + N; i < N; ++i, idxERow += N)
+                {
+                    for (unsigned int j = k + 1, idxP = idxPivot + 1, idxE = idxERow + 1; j < N; ++j, ++idxP, ++idxE)
+                    {
+                        A.elem[idxE] = (A.elem[idxPivot] * A.elem[idxE] - A.elem[idxERow] * A.elem[idxP]) / previous;
+                    }
+                }
+                previous = A.elem[idxPivot];
+            }
+
+            return negate ? -previous : previous;
+        }
+
+        template<typename ElementType>
+        bool Algorithms::getAdjointBareiss(const Matrix<ElementType>& mat, Matrix<ElementType>& adj, ElementType& det)
+        {
+            ASSERT_EXCEPTION(mat.cols == mat.rows, std::length_error);
+
+            const unsigned int N = mat.rows;
+
+            Matrix<ElementType> A = mat;
+            Matrix<ElementType> R = Matrix<ElementType>::identity(N, N);
+            ElementType previous = ElementTraits<ElementType>::one();
+            bool negate = false;
+
+            // Fraction-free Gauss-Jordan elimination: after step k, the diagonal entries of the rows up to k are all
+            // equal to the pivot, so in the end A is det * I and R is the adjoint (up to the sign of the row swaps)
+            for (unsigned int k = 0, idxPivotRow = 0; k < N; ++k, idxPivotRow += N)
+            {
+                unsigned int pivotRow = k;
+                unsigned int idxA = idxPivotRow + k;
+                while (pivotRow < N && A.elem[idxA] == ElementTraits<ElementType>::zero())
+                {
+                    ++pivotRow;
+                    idxA += N;
+                }
+                if (pivotRow == N)
+                {
+                    return false;
+                }
+                if (pivotRow != k)
+                {
+                    for (unsigned int j = 0, idxP = idxPivotRow, idxE = pivotRow * N; j < N; ++j, ++idxP, ++idxE)
+                    {
+                        std::swap(A.elem[idxP], A.elem[idxE]);
+                        std::swap(R.elem[idxP], R.elem[idxE]);
+                    }
+                    negate = !negate;
+                }
+
+                const ElementType pivot = A.elem[idxPivotRow + k];
+                for (unsigned int i = 0, idxERow = 0; i < N; ++i, idxERow += N)
+                {
+                    if (i == k)
+                    {
+                        continue;
+                    }
+                    const ElementType coef = A.elem[idxERow + k];
+                    for (unsigned int j = 0, idxP = idxPivotRow, idxE = idxERow; j < N; ++j, ++idxP, ++idxE)
+                    {
+                        if (j != k)
+                        {
+                            A.elem[idxE] = (pivot * A.elem[idxE] - coef * A.elem[idxP]) / previous;
+                        }
+                        R.elem[idxE] = (pivot * R.elem[idxE] - coef * R.elem[idxP]) / previous;
+                    }
+                    A.elem[idxERow + k] = ElementTraits<ElementType>::zero();
+                }
+                previous = pivot;
+            }
+
+            det = negate ? -previous : previous;
+            if (negate)
+            {
+                for (unsigned int i = 0; i < R.size(); ++i)
+                {
+                    R.elem[i] = -R.elem[i];
+                }
+            }
+            adj = R;
+
+            return true;
+        }
+
+        template<typename ElementType>
+        unsigned int Algorithms::getRankBareiss(const Matrix<ElementType>& mat)
+        {
+            const unsigned int N = mat.rows;
+            const unsigned int M = mat.cols;
+
+            Matrix<ElementType> A = mat;
+            ElementType previous = ElementTraits<ElementType>::one();
+
+            // Columns without a pivot are skipped, the eliminated entries are minors of the remaining columns
+            unsigned int rank = 0;
+            for (unsigned int col = 0; col < M && rank < N; ++col)
+            {
+                const unsigned int idxPivot = rank * M + col;
+                unsigned int pivotRow = rank;
+                unsigned int idxA = idxPivot;
+                while (pivotRow < N && A.elem[idxA] == ElementTraits<ElementType>::zero())
+                {
+                    ++pivotRow;
+                    idxA += M;
+                }
+                if (pivotRow == N)
+                {
+                    continue;
+                }
+                if (pivotRow != rank)
+                {
+                    for (unsigned int j = col, idxP = idxPivot, idxE = idxA; j < M; ++j, ++idxP, ++idxE)
+                    {
+                        std::swap(A.elem[idxP], A.elem[idxE]);
+                    }
+                }
+
+                for (unsigned int i = rank + 1, idxERow = idxPivot + M; i < N; ++i, idxERow += M)
+                {
+                    for (unsigned int j = col + 1, idxP = idxPivot + 1, idxE = idxERow + 1; j < M; ++j, ++idxP, ++idxE)
+                    {
+                        A.elem[idxE] = (A.elem[idxPivot] * A.elem[idxE] - A.elem[idxERow] * A.elem[idxP]) / previous;
+                    }
+                }
+                previous = A.elem[idxPivot];
+                ++rank;
+            }
+
+            return rank;
+        }
+
+        template<typename ElementType>
+        typename ElementTraits<ElementType>::RationalType Algorithms::det(const Matrix<ElementType>& mat, std::false_type)
         {
             ASSERT_EXCEPTION(mat.cols == mat.rows, std::length_error);
 
@@ -137,7 +394,7 @@ namespace GeNuSys
         }
 
         template<typename ElementType>
-        Matrix<typename ElementTraits<ElementType>::RationalType> Algorithms::invert(const Matrix<ElementType>& mat)
+        Matrix<typename ElementTraits<ElementType>::RationalType> Algorithms::invert(const Matrix<ElementType>& mat, std::false_type)
         {
             ASSERT_EXCEPTION(mat.cols == mat.rows, std::length_error);
 
@@ -226,15 +483,15 @@ namespace GeNuSys
 #ifdef __unix__
 
         template<typename ElementType>
-        Matrix<ElementType> Algorithms::getAdjoint(const Matrix<ElementType>& mat)
+        Matrix<ElementType> Algorithms::getAdjoint(const Matrix<ElementType>& mat, std::false_type)
         {
             Matrix<mpz_class> mpz_mat = mat;
-            Matrix<mpz_class> mpz_adj = Traits::convertUnsafe<mpq_class, mpz_class>(Algorithms::invert(mpz_mat) * Algorithms::det(mpz_mat));
+            Matrix<mpz_class> mpz_adj = Traits::convertUnsafe<mpq_class, mpz_class>(Algorithms::invert(mpz_mat, std::false_type()) * Algorithms::det(mpz_mat, std::false_type()));
 
             Matrix<ElementType> adj(mpz_adj.getRows(), mpz_adj.getCols());
             for (unsigned int i = 0; i < mpz_adj.size(); ++i)
             {
-                adj.elem[i] = mpz_get_si(mpz_adj.elem[i].get_mpz_t());
+                adj.elem[i] = ElementTraits<mpz_class>::template asTypeUnsafe<ElementType>(mpz_adj.elem[i]);
             }
 
             return adj;
@@ -243,11 +500,11 @@ namespace GeNuSys
 #else
 
         template<typename ElementType>
-        Matrix<ElementType> Algorithms::getAdjoint(const Matrix<ElementType>& mat)
+        Matrix<ElementType> Algorithms::getAdjoint(const Matrix<ElementType>& mat, std::false_type)
         {
             typedef typename ElementTraits<ElementType>::RationalType RationalType;
 
-            return Traits::convertUnsafe<RationalType, ElementType>(Algorithms::invert(mat) * Algorithms::det(mat));
+            return Traits::convertUnsafe<RationalType, ElementType>(Algorithms::invert(mat, std::false_type()) * Algorithms::det(mat, std::false_type()));
         }
 
 #endif // __unix__
@@ -752,7 +1009,7 @@ namespace GeNuSys
         }
 
         template<typename ElementType>
-        unsigned int Algorithms::getRank(const Matrix<ElementType>& mat)
+        unsigned int Algorithms::getRank(const Matrix<ElementType>& mat, std::false_type)
         {
             typedef typename ElementTraits<ElementType>::RationalType RationalType;
             typedef typename ElementTraits<RationalType>::AbsType AbsType;
@@ -1113,5 +1370,169 @@ namespace GeNuSys
             return JordanForm<ElementType>(invert(P), J, P);
         }
 
+        template<typename ElementType>
+        bool Algorithms::reduceLLL(Matrix<ElementType>& basis, const Matrix<double>& gram, bool deepInsertions, double delta, unsigned long long maxIterations)
+        {
+            const unsigned int n = basis.rows;
+            const unsigned int N = basis.cols;
+            const Matrix<ElementType> original = basis;
+
+            // The Gram-Schmidt coefficients are kept in floating point, the basis stays exact
+            std::vector<double> rows(n * N);
+            std::vector<double> mu(n * n), B(n);
+            auto load = [&](unsigned int i)
+            {
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    rows[i * N + j] = ElementTraits<ElementType>::template asType<double>(basis(i, j));
+                }
+            };
+            auto inner = [&](unsigned int i, unsigned int j)
+            {
+                double sum = 0.0;
+                for (unsigned int a = 0; a < N; ++a)
+                {
+                    double row = 0.0;
+                    for (unsigned int b = 0; b < N; ++b)
+                    {
+                        row += gram(a, b) * rows[j * N + b];
+                    }
+                    sum += rows[i * N + a] * row;
+                }
+
+                return sum;
+            };
+            auto orthogonalize = [&](unsigned int from)
+            {
+                for (unsigned int i = from; i < n; ++i)
+                {
+                    for (unsigned int j = 0; j < i; ++j)
+                    {
+                        double sum = inner(i, j);
+                        for (unsigned int l = 0; l < j; ++l)
+                        {
+                            sum -= mu[j * n + l] * mu[i * n + l] * B[l];
+                        }
+                        mu[i * n + j] = sum / B[j];
+                    }
+                    B[i] = inner(i, i);
+                    for (unsigned int l = 0; l < i; ++l)
+                    {
+                        B[i] -= mu[i * n + l] * mu[i * n + l] * B[l];
+                    }
+                }
+            };
+
+            // The coefficients lost all precision if a projected row has no positive length, or a multiplier
+            // is beyond the integers which double represents exactly
+            auto degenerate = [&](unsigned int from)
+            {
+                for (unsigned int i = from; i < n; ++i)
+                {
+                    if (!(B[i] > 0.0) || !std::isfinite(B[i]))
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            };
+            const double maxMultiplier = 9007199254740992.0;
+
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                load(i);
+            }
+            orthogonalize(0);
+            if (degenerate(0))
+            {
+                return false;
+            }
+
+            // Rounding errors in the Gram-Schmidt updates can make the swaps cycle on ill-conditioned bases
+            unsigned long long iterations = 0;
+            unsigned int k = 1;
+            while (k < n)
+            {
+                if (++iterations > maxIterations)
+                {
+                    basis = original;
+                    return false;
+                }
+
+                // Size reduction of row k
+                for (int j = k - 1; j >= 0; --j)
+                {
+                    double q = std::round(mu[k * n + j]);
+                    if (q == 0.0)
+                    {
+                        continue;
+                    }
+                    if (!(std::abs(q) <= maxMultiplier))
+                    {
+                        basis = original;
+                        return false;
+                    }
+                    ElementType c = ElementTraits<double>::template asTypeUnsafe<ElementType>(q);
+                    for (unsigned int a = 0; a < N; ++a)
+                    {
+                        basis.set(k, a, basis(k, a) - c * basis(j, a));
+                    }
+                    load(k);
+                    for (int l = 0; l < j; ++l)
+                    {
+                        mu[k * n + l] -= q * mu[j * n + l];
+                    }
+                    mu[k * n + j] -= q;
+                }
+
+                // Insert row k at the first position i where it is shorter than B[i] after projection
+                unsigned int insert = k;
+                if (deepInsertions)
+                {
+                    double C = inner(k, k);
+                    for (unsigned int i = 0; i < k; ++i)
+                    {
+                        if (C < delta * B[i])
+                        {
+                            insert = i;
+                            break;
+                        }
+                        C -= mu[k * n + i] * mu[k * n + i] * B[i];
+                    }
+                }
+                else if (B[k] < (delta - mu[k * n + k - 1] * mu[k * n + k - 1]) * B[k - 1])
+                {
+                    insert = k - 1;
+                }
+
+                if (insert == k)
+                {
+                    ++k;
+                    continue;
+                }
+                for (unsigned int i = k; i > insert; --i)
+                {
+                    for (unsigned int a = 0; a < N; ++a)
+                    {
+                        ElementType t = basis(i, a);
+                        basis.set(i, a, basis(i - 1, a));
+                        basis.set(i - 1, a, t);
+                    }
+                    load(i);
+                    load(i - 1);
+                }
+                orthogonalize(insert);
+                if (degenerate(insert))
+                {
+                    basis = original;
+                    return false;
+                }
+                k = std::max(insert, 1u);
+            }
+
+            return true;
+        }
+
     }
 }
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define GENUSYS_LINALG_OPERATIONS_H_
 
 #include "element_traits.h"
+#include "divider.h"
 
 #include "vector.h"
 #include "sparse_vector.h"
@@ -83,6 +84,33 @@ namespace GeNuSys
             template<typename ElementType>
             static void vct_mods(SparseVector<ElementType>& vct, const ElementType& value);
 
+            // Variants for a divisor fixed in advance, for loops dividing by the same value many times
+
+            template<typename ElementType>
+            static void vct_idiv(const Vector<ElementType>& vct, const Divider<ElementType>& divider, Vector<ElementType>& result);
+
+            template<typename ElementType>
+            static void vct_idiv(Vector<ElementType>& vct, const Divider<ElementType>& divider);
+
+            // The elements of vct must be divisible by the divisor
+            template<typename ElementType>
+            static void vct_exdiv(const Vector<ElementType>& vct, const Divider<ElementType>& divider, Vector<ElementType>& result);
+
+            template<typename ElementType>
+            static void vct_exdiv(Vector<ElementType>& vct, const Divider<ElementType>& divider);
+
+            template<typename ElementType>
+            static void vct_mod(const Vector<ElementType>& vct, const Divider<ElementType>& divider, Vector<ElementType>& result);
+
+            template<typename ElementType>
+            static void vct_mod(Vector<ElementType>& vct, const Divider<ElementType>& divider);
+
+            template<typename ElementType>
+            static void vct_mods(const Vector<ElementType>& vct, const Divider<ElementType>& divider, Vector<ElementType>& result);
+
+            template<typename ElementType>
+            static void vct_mods(Vector<ElementType>& vct, const Divider<ElementType>& divider);
+
             template<typename ElementType>
             static void vct_div(const Vector<ElementType>& vct, const ElementType& value, Vector<typename ElementTraits<ElementType>::RationalType>& result);
 
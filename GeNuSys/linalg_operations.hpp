@@ -180,6 +180,78 @@ namespace GeNuSys
             }
         }
 
+        template<typename ElementType>
+        void Operations::vct_idiv(const Vector<ElementType>& vct, const Divider<ElementType>& divider, Vector<ElementType>& result)
+        {
+            for (unsigned int i = 0; i < vct.length; ++i)
+            {
+                result.elem[i] = divider.quotient(vct.elem[i]);
+            }
+        }
+
+        template<typename ElementType>
+        void Operations::vct_idiv(Vector<ElementType>& vct, const Divider<ElementType>& divider)
+        {
+            for (unsigned int i = 0; i < vct.length; ++i)
+            {
+                vct.elem[i] = divider.quotient(vct.elem[i]);
+            }
+        }
+
+        template<typename ElementType>
+        void Operations::vct_exdiv(const Vector<ElementType>& vct, const Divider<ElementType>& divider, Vector<ElementType>& result)
+        {
+            for (unsigned int i = 0; i < vct.length; ++i)
+            {
+                result.elem[i] = divider.exactQuotient(vct.elem[i]);
+            }
+        }
+
+        template<typename ElementType>
+        void Operations::vct_exdiv(Vector<ElementType>& vct, const Divider<ElementType>& divider)
+        {
+            for (unsigned int i = 0; i < vct.length; ++i)
+            {
+                vct.elem[i] = divider.exactQuotient(vct.elem[i]);
+            }
+        }
+
+        template<typename ElementType>
+        void Operations::vct_mod(const Vector<ElementType>& vct, const Divider<ElementType>& divider, Vector<ElementType>& result)
+        {
+            for (unsigned int i = 0; i < vct.length; ++i)
+            {
+                result.elem[i] = divider.mod(vct.elem[i]);
+            }
+        }
+
+        template<typename ElementType>
+        void Operations::vct_mod(Vector<ElementType>& vct, const Divider<ElementType>& divider)
+        {
+            for (unsigned int i = 0; i < vct.length; ++i)
+            {
+                vct.elem[i] = divider.mod(vct.elem[i]);
+            }
+        }
+
+        template<typename ElementType>
+        void Operations::vct_mods(const Vector<ElementType>& vct, const Divider<ElementType>& divider, Vector<ElementType>& result)
+        {
+            for (unsigned int i = 0; i < vct.length; ++i)
+            {
+                result.elem[i] = divider.mods(vct.elem[i]);
+            }
+        }
+
+        template<typename ElementType>
+        void Operations::vct_mods(Vector<ElementType>& vct, const Divider<ElementType>& divider)
+        {
+            for (unsigned int i = 0; i < vct.length; ++i)
+            {
+                vct.elem[i] = divider.mods(vct.elem[i]);
+            }
+        }
+
         template<typename ElementType>
         void Operations::vct_div(const Vector<ElementType>& vct, const ElementType& value, Vector<typename ElementTraits<ElementType>::RationalType>& result)
         {
@@ -1746,7 +1818,7 @@ namespace GeNuSys
         {
             ASSERT_EXCEPTION(op1.cols == op2.rows, std::length_error);
 
-            result.elem.clear();
+            std::fill(result.elem.begin(), result.elem.end(), ElementTraits<ElementType>::zero());
 
             for (unsigned int rowA = 0, idxA = 0, idxR = 0; rowA < op1.rows; ++rowA, idxR += op2.cols)
             {
@@ -0,0 +1,108 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GENUSYS_NUMSYS_LOOKUP_HASH_H_
+#define GENUSYS_NUMSYS_LOOKUP_HASH_H_
+
+#include <vector>
+
+#include "vector.h"
+#include "smith_hash.h"
+
+// Largest number of residue combinations for which the hash is computed by table lookups, 0 disables it
+#ifndef GENUSYS_LOOKUP_HASH_MAX_SIZE
+#define GENUSYS_LOOKUP_HASH_MAX_SIZE 65536
+#endif
+
+// Coordinates in [-GENUSYS_LOOKUP_HASH_RANGE, GENUSYS_LOOKUP_HASH_RANGE] are hashed by table lookups
+#ifndef GENUSYS_LOOKUP_HASH_RANGE
+#define GENUSYS_LOOKUP_HASH_RANGE 1024
+#endif
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        // SmithHash by table lookups, for small Smith invariants G. The residues of U * z modulo G are packed into
+        // a single integer with fields wide enough to hold the sum of the residues of every coordinate, so the
+        // contributions of the coordinates, each looked up from a table, can be added up without carries. A second
+        // table maps the sum to the hash.
+        class LookupHash
+        {
+
+            private:
+
+                unsigned int length;
+
+                long long range;
+
+                unsigned long long width;
+
+                bool enabled;
+
+                // The packed residues of z[j] * e_j are at table[j * width + z[j] + range]
+                std::vector<unsigned int> table;
+
+                std::vector<unsigned long long> reduction;
+
+            public:
+
+                template <
+                    typename ElementType,
+                    template<typename> class MatrixType
+                    >
+                LookupHash(const SmithHash<ElementType, MatrixType>& hash, unsigned int length, long long range = GENUSYS_LOOKUP_HASH_RANGE);
+
+                // False if the Smith invariants are too big for the tables
+                bool isEnabled() const
+                {
+                    return enabled;
+                }
+
+                long long getRange() const
+                {
+                    return range;
+                }
+
+                // Packed residues of value * e_j, value must be in [-range, range]
+                unsigned int get(unsigned int j, long long value) const
+                {
+                    return table[j * width + (unsigned long long) (value + range)];
+                }
+
+                // The hash of the point whose packed residues, i.e. the sum of get(j, z[j]), is packed
+                unsigned long long reduce(unsigned int packed) const
+                {
+                    return reduction[packed];
+                }
+
+                // Sets h to the hash of z and returns true, or returns false if z is out of the range of the tables
+                template<typename ElementType>
+                bool operator()(const GeNuSys::LinAlg::Vector<ElementType>& z, unsigned long long& h) const;
+
+        };
+
+    }
+}
+
+// Include implementation
+#include "lookup_hash.hpp"
+
+#endif // GENUSYS_NUMSYS_LOOKUP_HASH_H_
@@ -0,0 +1,113 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <type_traits>
+
+#include "element_traits.h"
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        template <
+            typename ElementType,
+            template<typename> class MatrixType
+            >
+        LookupHash::LookupHash(const SmithHash<ElementType, MatrixType>& hash, unsigned int length, long long range): length(length), range(range), width(2 * range + 1)
+        {
+            unsigned int size = hash.getSize();
+
+            // Arbitrary precision types may hold coordinates which do not even fit into a long long
+            enabled = false;
+            if (!std::is_integral<ElementType>::value || GENUSYS_LOOKUP_HASH_MAX_SIZE == 0)
+            {
+                return;
+            }
+
+            // Field i holds at most length * (G[i] - 1)
+            std::vector<long long> G(size);
+            std::vector<unsigned long long> fieldWidth(size);
+            std::vector<unsigned long long> fieldBase(size);
+            unsigned long long total = 1;
+            for (unsigned int i = 0; i < size; ++i)
+            {
+                G[i] = ElementTraits<ElementType>::template asTypeUnsafe<long long>(hash.getG()[i]);
+                if (G[i] > GENUSYS_LOOKUP_HASH_MAX_SIZE)
+                {
+                    return;
+                }
+                fieldWidth[i] = length * (unsigned long long) (G[i] - 1) + 1;
+                fieldBase[i] = total;
+                if (fieldWidth[i] > GENUSYS_LOOKUP_HASH_MAX_SIZE / total)
+                {
+                    return;
+                }
+                total *= fieldWidth[i];
+            }
+            enabled = true;
+
+            table.resize(length * width);
+            for (unsigned int j = 0; j < length; ++j)
+            {
+                for (long long value = -range; value <= range; ++value)
+                {
+                    unsigned long long packed = 0;
+                    for (unsigned int i = 0; i < size; ++i)
+                    {
+                        long long u = ElementTraits<ElementType>::template asTypeUnsafe<long long>(ElementTraits<ElementType>::mod(hash.getU()(i, j), hash.getG()[i]));
+                        packed += ElementTraits<long long>::mod(u * ElementTraits<long long>::mod(value, G[i]), G[i]) * fieldBase[i];
+                    }
+                    table[j * width + (value + range)] = (unsigned int) packed;
+                }
+            }
+
+            reduction.resize(total);
+            for (unsigned long long packed = 0; packed < total; ++packed)
+            {
+                unsigned long long h = 0;
+                for (unsigned int i = 0; i < size; ++i)
+                {
+                    unsigned long long field = packed / fieldBase[i] % fieldWidth[i];
+                    h += (field % G[i]) * ElementTraits<ElementType>::template asTypeUnsafe<long long>(hash.getProdG()[i]);
+                }
+                reduction[packed] = h;
+            }
+        }
+
+        template<typename ElementType>
+        bool LookupHash::operator()(const GeNuSys::LinAlg::Vector<ElementType>& z, unsigned long long& h) const
+        {
+            unsigned int packed = 0;
+            for (unsigned int j = 0; j < length; ++j)
+            {
+                unsigned long long offset = (unsigned long long) (ElementTraits<ElementType>::template asTypeUnsafe<long long>(z[j]) + range);
+                if (offset >= width)
+                {
+                    return false;
+                }
+                packed += table[j * width + offset];
+            }
+            h = reduction[packed];
+
+            return true;
+        }
+
+    }
+}
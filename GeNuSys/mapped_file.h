@@ -0,0 +1,123 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GENUSYS_NUMSYS_MAPPED_FILE_H_
+#define GENUSYS_NUMSYS_MAPPED_FILE_H_
+
+#include <string>
+#include <stdexcept>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif // __unix__
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        // Zero initialized scratch memory backed by a file, so the OS can page it out to disk.
+        // The file is unlinked right after it is mapped, so nothing is left behind even if the process is killed.
+        class MappedFile
+        {
+
+            private:
+
+                void* addr;
+
+                unsigned long long length;
+
+                unsigned long long pageSize;
+
+            public:
+
+                MappedFile(const std::string& fileName, unsigned long long length): addr(0), length(length)
+                {
+#ifdef __unix__
+                    pageSize = sysconf(_SC_PAGESIZE);
+
+                    int fd = open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+                    if (fd < 0)
+                    {
+                        throw std::runtime_error{"Cannot open file " + fileName};
+                    }
+                    if (ftruncate(fd, length) != 0)
+                    {
+                        close(fd);
+                        unlink(fileName.c_str());
+                        throw std::runtime_error{"Cannot resize file " + fileName};
+                    }
+                    addr = mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                    close(fd);
+                    unlink(fileName.c_str());
+                    if (addr == MAP_FAILED)
+                    {
+                        throw std::runtime_error{"Cannot map file " + fileName};
+                    }
+
+                    // Orbits jump around the whole table, read-ahead only pays off for the scan cursor (see prefetch)
+                    madvise(addr, length, MADV_RANDOM);
+#else
+                    throw std::runtime_error{"File backed storage is not supported on this platform"};
+#endif // __unix__
+                }
+
+                MappedFile(const MappedFile&) = delete;
+
+                MappedFile& operator =(const MappedFile&) = delete;
+
+                ~MappedFile()
+                {
+#ifdef __unix__
+                    munmap(addr, length);
+#endif // __unix__
+                }
+
+                void* data() const
+                {
+                    return addr;
+                }
+
+                // Hints the OS that the given byte range will be needed soon
+                void prefetch(unsigned long long from, unsigned long long to) const
+                {
+#ifdef __unix__
+                    from -= from % pageSize;
+                    if (to > length)
+                    {
+                        to = length;
+                    }
+                    if (from < to)
+                    {
+                        madvise((char*) addr + from, to - from, MADV_WILLNEED);
+                    }
+#else
+                    (void) from;
+                    (void) to;
+#endif // __unix__
+                }
+
+        };
+
+    }
+}
+
+#endif // GENUSYS_NUMSYS_MAPPED_FILE_H_
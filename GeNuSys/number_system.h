@@ -33,12 +33,44 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "digit_set.h"
 #include "hash_table.h"
 #include "smith_hash.h"
+#include "vector_coder.h"
+#include "domain_coder.h"
+#include "attractor_sieve.h"
+#include "cycle_checkpoint.h"
+
+#include <string>
+#include <type_traits>
 
 namespace GeNuSys
 {
     namespace NumSys
     {
 
+        struct CycleSearchOptions
+        {
+            // If not empty, the visited set of the scan is kept in a memory mapped file of this name
+            // instead of memory, so the OS can page it out for volumes which do not fit into RAM.
+            // Concurrent scans (several threads or lanes) keep 2 bits per point, the claimed points in
+            // this file and the settled ones in a second file of the same size with ".settled" appended.
+            std::string visitedSetFile;
+
+            // If not empty, the state of the scan is saved to this file every checkpointInterval seconds,
+            // so that resumeCycles can continue an interrupted search from there
+            std::string checkpointFile;
+
+            unsigned int checkpointInterval;
+
+            // Skip the start points which are proven not to be periodic, see AttractorSieve
+            bool sieveStartPoints;
+
+            // Find the cycle of every start point with Brent's cycle detection instead of marking the visited points,
+            // so the memory used grows with the number of cycles instead of the size of the search space, at the cost
+            // of walking orbits more than once (see BrentWalk). visitedSetFile is not used then.
+            bool boundedMemory;
+
+            CycleSearchOptions(): checkpointInterval(600), sieveStartPoints(true), boundedMemory(false) {}
+        };
+
         template <
             typename ElementType,
             template<typename> class VectorType,
@@ -48,6 +80,52 @@ namespace GeNuSys
         class NumberSystem
         {
 
+            public:
+
+                // Walks the orbit of a point, the buffers of the steps are allocated once
+                class OrbitWalker
+                {
+
+                    private:
+
+                        const NumberSystem* numSys;
+
+                        GeNuSys::LinAlg::Vector<ElementType> Uz;
+
+                        GeNuSys::LinAlg::Vector<ElementType> act[2];
+
+                        int actIdx;
+
+                    public:
+
+                        OrbitWalker(const NumberSystem& numSys, const GeNuSys::LinAlg::Vector<ElementType>& z): numSys(&numSys), Uz(numSys.hash.createCache()), actIdx(0)
+                        {
+                            act[0] = act[1] = z;
+                        }
+
+                        // Restarts the walk from z
+                        void reset(const GeNuSys::LinAlg::Vector<ElementType>& z)
+                        {
+                            act[0] = z;
+                            actIdx = 0;
+                        }
+
+                        const GeNuSys::LinAlg::Vector<ElementType>& get() const
+                        {
+                            return act[actIdx];
+                        }
+
+                        // Moves to the image of the current point under phi, returns the digit of the step
+                        const VectorType<ElementType>& step()
+                        {
+                            const VectorType<ElementType>& digit = numSys->phi(act[actIdx], act[1 - actIdx], Uz);
+                            actIdx = 1 - actIdx;
+
+                            return digit;
+                        }
+
+                };
+
             private:
 
                 RadixProperties<ElementType> props;
@@ -58,8 +136,181 @@ namespace GeNuSys
 
                 HashTable<ElementType, VectorType, MatrixType> hashTable;
 
+                // The adjoint of a companion-like base has O(N) non-zero entries, phi multiplies by its sparse form then
+                GeNuSys::LinAlg::SparseMatrix<ElementType> sparseAdjoint;
+
+                bool adjointSparse;
+
                 Norm norm;
 
+                // Collects the cycles and returns them at once, in canonical order
+                struct CycleCollector
+                {
+                    const NumberSystem& numSys;
+
+                    std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> result;
+
+                    CycleCollector(const NumberSystem& numSys): numSys(numSys) {}
+
+                    template <typename Coder>
+                    bool found(const Coder&, const std::vector<unsigned long long>&)
+                    {
+                        return true;
+                    }
+
+                    template <typename Coder>
+                    void finished(const Coder& coder, std::vector<std::vector<unsigned long long>>& cycles)
+                    {
+                        result = numSys.decodeCycles(coder, cycles);
+                    }
+                };
+
+                // Passes every cycle to the visitor as soon as it is found
+                template <typename Visitor>
+                struct CycleVisitor
+                {
+                    const NumberSystem& numSys;
+
+                    Visitor& visitor;
+
+                    CycleVisitor(const NumberSystem& numSys, Visitor& visitor): numSys(numSys), visitor(visitor) {}
+
+                    template <typename Coder>
+                    bool found(const Coder& coder, const std::vector<unsigned long long>& cycle)
+                    {
+                        return visitor(numSys.decodeCycle(coder, cycle));
+                    }
+
+                    template <typename Coder>
+                    void finished(const Coder&, std::vector<std::vector<unsigned long long>>&)
+                    {
+                    }
+                };
+
+                // Applies phi to the current point of an orbit and encodes the result. Steppers walk a fixed
+                // number of orbits (lanes) at once, load sets the point of a lane, step advances every lane.
+                template <typename Coder>
+                struct PhiStepper
+                {
+                    static const unsigned int lanes = 1;
+
+                    const NumberSystem* numSys;
+
+                    const Coder* coder;
+
+                    // Set if phi might overflow long long on the domain, the steps then go through stepChecked
+                    bool checked;
+
+                    // The last loaded point, scans load consecutive codes, which are cheaper to step to than to decode
+                    GeNuSys::LinAlg::Vector<ElementType> cursor;
+
+                    unsigned long long cursorCode;
+
+                    OrbitWalker walker;
+
+                    // The current point and its image of the checked steps
+                    GeNuSys::LinAlg::Vector<ElementType> point;
+
+                    GeNuSys::LinAlg::Vector<ElementType> image;
+
+                    PhiStepper(const NumberSystem& numSys, const Coder& coder): numSys(&numSys), coder(&coder),
+                        checked(numSys.phiMightOverflow(coder.getBox(), std::is_same<ElementType, long long>())), cursor(numSys.props.getBase().getRows()), cursorCode(0),
+                        walker(numSys, cursor), point(cursor), image(cursor)
+                    {
+                        coder.decode(0, cursor);
+                    }
+
+                    void load(unsigned int, unsigned long long code)
+                    {
+                        if (code == cursorCode + 1)
+                        {
+                            coder->increment(cursor);
+                        }
+                        else if (code != cursorCode)
+                        {
+                            coder->decode(code, cursor);
+                        }
+                        cursorCode = code;
+
+                        if (checked)
+                        {
+                            point = cursor;
+                        }
+                        else
+                        {
+                            walker.reset(cursor);
+                        }
+                    }
+
+                    void step(unsigned long long* codes, bool* valid)
+                    {
+                        if (checked)
+                        {
+                            numSys->stepChecked(point, image, coder->getBox(), std::is_same<ElementType, long long>());
+                            point = image;
+                            codes[0] = coder->encode(point, valid[0]);
+                            return;
+                        }
+
+                        walker.step();
+
+                        codes[0] = coder->encode(walker.get(), valid[0]);
+                    }
+                };
+
+                // Scans the search space and calls handler.found with every new cycle, stops when it returns false.
+                // Returns true if the whole space was scanned.
+                template <typename CycleHandler>
+                bool findCycles(const CycleSearchOptions& options, bool resume, CycleHandler& handler);
+
+                // Scans the domain of coder, which contains every periodic point
+                template <typename CycleHandler, typename Coder>
+                bool findCycles(const CycleSearchOptions& options, bool resume, CycleHandler& handler, const Coder& coder);
+
+                // Identifies the number system, the domain and the options of a search, resuming a checkpoint with a
+                // different fingerprint would give wrong cycles
+                template <typename Coder>
+                unsigned long long getFingerprint(const CycleSearchOptions& options, const Coder& coder) const;
+
+                // Selects the fastest stepper available for the element type and the dimension
+                template <typename CycleHandler, typename Coder>
+                bool dispatchScan(const CycleSearchOptions& options, bool resume, CycleHandler& handler, const Coder& coder, CycleCheckpoint& checkpoint, std::false_type);
+
+                template <typename CycleHandler, typename Coder>
+                bool dispatchScan(const CycleSearchOptions& options, bool resume, CycleHandler& handler, const Coder& coder, CycleCheckpoint& checkpoint, std::true_type);
+
+                template <typename CycleHandler, typename Coder, unsigned int D>
+                bool dispatchScan(const CycleSearchOptions& options, bool resume, CycleHandler& handler, const Coder& coder, CycleCheckpoint& checkpoint,
+                                  std::integral_constant<unsigned int, D>);
+
+                template <typename CycleHandler, typename Coder>
+                bool dispatchScan(const CycleSearchOptions& options, bool resume, CycleHandler& handler, const Coder& coder, CycleCheckpoint& checkpoint,
+                                  std::integral_constant<unsigned int, 0>);
+
+                // The generic phi does not detect overflows, true if it might overflow long long on the box
+                bool phiMightOverflow(const VectorCoder& box, std::true_type) const;
+
+                bool phiMightOverflow(const VectorCoder& box, std::false_type) const;
+
+                // Applies phi in long long with overflow checks, and redoes the step in mpz_class if it overflows.
+                // Images outside of the box are clamped to just outside of it, so that they still encode as invalid.
+                void stepChecked(const GeNuSys::LinAlg::Vector<ElementType>& z, GeNuSys::LinAlg::Vector<ElementType>& phiZ, const VectorCoder& box, std::true_type) const;
+
+                void stepChecked(const GeNuSys::LinAlg::Vector<ElementType>& z, GeNuSys::LinAlg::Vector<ElementType>& phiZ, const VectorCoder& box, std::false_type) const;
+
+                template <typename CycleHandler, typename Coder, typename Stepper>
+                bool scanCycles(const CycleSearchOptions& options, bool resume, CycleHandler& handler, const Coder& coder, CycleCheckpoint& checkpoint, const Stepper& prototype);
+
+                // The scan of options.boundedMemory, the checkpoints have an empty visited set
+                template <typename CycleHandler, typename Coder, typename Stepper>
+                bool scanCyclesBounded(const CycleSearchOptions& options, bool resume, CycleHandler& handler, const Coder& coder, CycleCheckpoint& checkpoint, const Stepper& prototype);
+
+                template <typename Coder>
+                std::vector<GeNuSys::LinAlg::Vector<ElementType>> decodeCycle(const Coder& coder, std::vector<unsigned long long> cycle) const;
+
+                template <typename Coder>
+                std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> decodeCycles(const Coder& coder, std::vector<std::vector<unsigned long long>>& cycles) const;
+
             public:
 
                 NumberSystem(const RadixProperties<ElementType>& props, const std::vector<VectorType<ElementType>>& digitSet, const Norm& norm);
@@ -72,7 +323,28 @@ namespace GeNuSys
 
                 std::vector<GeNuSys::LinAlg::Vector<ElementType>> getOrbit(const GeNuSys::LinAlg::Vector<ElementType>& z);
 
-                std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> getCycles();
+                std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> getCycles(const CycleSearchOptions& options = CycleSearchOptions());
+
+                // Continues the search saved in options.checkpointFile, with the same number system and options
+                std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> resumeCycles(const CycleSearchOptions& options);
+
+                // Searches the domain of coder instead of the whole box of Traits::getBounds, e.g. a PolytopeCoder
+                // or an EllipsoidCoder of the number system. The domain must contain every periodic point.
+                template <typename Coder>
+                std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> getCycles(const CycleSearchOptions& options, const Coder& coder);
+
+                template <typename Coder>
+                std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> resumeCycles(const CycleSearchOptions& options, const Coder& coder);
+
+                // Calls visitor(cycle) with every cycle as soon as it is found, where cycle is a
+                // std::vector<Vector<ElementType>> ending with its first element. The search stops when the
+                // visitor returns false. Calls are serialized, but come in no particular order.
+                // Returns true if the whole search space was scanned.
+                template <typename Visitor>
+                bool visitCycles(Visitor visitor, const CycleSearchOptions& options = CycleSearchOptions());
+
+                template <typename Visitor, typename Coder>
+                bool visitCycles(Visitor visitor, const CycleSearchOptions& options, const Coder& coder);
 
         };
 
@@ -17,39 +17,33 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_set>
+
 #include "numsys_traits.h"
 
 #include "bit_vector.h"
-#include "vector_coder.h"
+#include "brent_walk.h"
+#include "cycle_checkpoint.h"
+#include "fixed_phi.h"
+#include "threading.h"
 
 #ifndef GENUSYS_NO_THREADING
 #include <thread>
+#include <atomic>
 #include <mutex>
+
+#include "range_scheduler.h"
+#include "orbit_walk.h"
 #endif
 
 namespace GeNuSys
 {
-#ifndef GENUSYS_NO_THREADING
-    struct thread_count
-    {
-        public:
-            static uint32_t get()
-            {
-                return tc();
-            }
-            static void set(uint32_t t_c)
-            {
-                tc() = t_c;
-            }
-        private:
-            static uint32_t& tc()
-            {
-                static uint32_t _tc = 1;
-                return _tc;
-            }
-    };
-#endif
-
     namespace NumSys
     {
 
@@ -60,8 +54,21 @@ namespace GeNuSys
             typename Norm
             >
         NumberSystem<ElementType, VectorType, MatrixType, Norm>::NumberSystem(const RadixProperties<ElementType>& props,
-                                                                              const std::vector<VectorType<ElementType>>& digitSet, const Norm& norm): props(props), digitSet(digitSet), hash(props), hashTable(hash, digitSet), norm(norm)
+                                                                              const std::vector<VectorType<ElementType>>& digitSet, const Norm& norm): props(props), digitSet(digitSet), hash(props), hashTable(hash, digitSet, props.getAdjoint()),
+                                                                              sparseAdjoint(props.getAdjoint()), norm(norm)
         {
+            unsigned int nonZeros = 0;
+            for (unsigned int i = 0; i < props.getAdjoint().getRows(); ++i)
+            {
+                for (unsigned int j = 0; j < props.getAdjoint().getCols(); ++j)
+                {
+                    if (props.getAdjoint()(i, j) != ElementTraits<ElementType>::zero())
+                    {
+                        ++nonZeros;
+                    }
+                }
+            }
+            adjointSparse = (2 * nonZeros <= props.getAdjoint().getRows() * props.getAdjoint().getCols());
         }
 
         template <
@@ -73,7 +80,7 @@ namespace GeNuSys
         GeNuSys::LinAlg::Vector<ElementType> NumberSystem<ElementType, VectorType, MatrixType, Norm>::phi(const GeNuSys::LinAlg::Vector<ElementType>& z) const
         {
             GeNuSys::LinAlg::Vector<ElementType> phiZ = props.getAdjoint() * (z - hashTable(z));
-            GeNuSys::LinAlg::Operations::vct_idiv(phiZ, props.getDet());
+            GeNuSys::LinAlg::Operations::vct_exdiv(phiZ, props.getDetDivider());
 
             return phiZ;
         }
@@ -86,12 +93,24 @@ namespace GeNuSys
             >
         const VectorType<ElementType>& NumberSystem<ElementType, VectorType, MatrixType, Norm>::phi(GeNuSys::LinAlg::Vector<ElementType>& z, GeNuSys::LinAlg::Vector<ElementType>& phiZ, GeNuSys::LinAlg::Vector<ElementType>& Uz) const
         {
-            const VectorType<ElementType>& digit = hashTable(z, Uz);
-            GeNuSys::LinAlg::Operations::vct_sub(z, digit);
-            GeNuSys::LinAlg::Operations::mat_mul(props.getAdjoint(), z, phiZ);
-            GeNuSys::LinAlg::Operations::vct_idiv(phiZ, props.getDet());
+            // adjoint * (z - digit), with adjoint * digit taken from the table
+            unsigned long long idx = hashTable.index(z, Uz);
+            if (adjointSparse)
+            {
+                GeNuSys::LinAlg::Operations::mat_mul(sparseAdjoint, z, phiZ);
+            }
+            else
+            {
+                GeNuSys::LinAlg::Operations::mat_mul(props.getAdjoint(), z, phiZ);
+            }
+            const ElementType* adjointDigit = hashTable.getAdjointDigitRow(idx);
+            for (unsigned int i = 0; i < phiZ.getLength(); ++i)
+            {
+                phiZ.set(i, phiZ[i] - adjointDigit[i]);
+            }
+            GeNuSys::LinAlg::Operations::vct_exdiv(phiZ, props.getDetDivider());
 
-            return digit;
+            return hashTable.getDigit(idx);
         }
 
         template <
@@ -104,15 +123,12 @@ namespace GeNuSys
         {
             std::vector<VectorType<ElementType>> result;
 
-            GeNuSys::LinAlg::Vector<ElementType> Uz = hash.createCache();
-            GeNuSys::LinAlg::Vector<ElementType> act[2] = { z, z };
-            int i = 0;
+            OrbitWalker walker(*this, z);
             do
             {
-                result.push_back(phi(act[i], act[(i + 1) % 2], Uz));
-                i = (i + 1) % 2;
+                result.push_back(walker.step());
             }
-            while (GeNuSys::LinAlg::PNorm<00>::norm(act[i]) != ElementTraits<ElementType>::zero());
+            while (GeNuSys::LinAlg::PNorm<00>::norm(walker.get()) != ElementTraits<ElementType>::zero());
 
             return result;
         }
@@ -129,16 +145,13 @@ namespace GeNuSys
 
             result.push_back(z);
 
-            GeNuSys::LinAlg::Vector<ElementType> Uz = hash.createCache();
-            GeNuSys::LinAlg::Vector<ElementType> act[2] = { z, z };
-            int i = 0;
+            OrbitWalker walker(*this, z);
             do
             {
-                phi(act[i], act[(i + 1) % 2], Uz);
-                result.push_back(act[(i + 1) % 2]);
-                i = (i + 1) % 2;
+                walker.step();
+                result.push_back(walker.get());
             }
-            while (GeNuSys::LinAlg::PNorm<00>::norm(act[i]) != ElementTraits<ElementType>::zero());
+            while (GeNuSys::LinAlg::PNorm<00>::norm(walker.get()) != ElementTraits<ElementType>::zero());
 
             return result;
         }
@@ -149,158 +162,893 @@ namespace GeNuSys
             template<typename> class MatrixType,
             typename Norm
             >
-        std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> NumberSystem<ElementType, VectorType, MatrixType, Norm>::getCycles()
+        std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> NumberSystem<ElementType, VectorType, MatrixType, Norm>::getCycles(const CycleSearchOptions& options)
         {
-            const unsigned int N = props.getBase().getRows();
+            CycleCollector collector(*this);
+            findCycles(options, false, collector);
+
+            return collector.result;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> NumberSystem<ElementType, VectorType, MatrixType, Norm>::resumeCycles(const CycleSearchOptions& options)
+        {
+            CycleCollector collector(*this);
+            findCycles(options, true, collector);
+
+            return collector.result;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename Visitor>
+        bool NumberSystem<ElementType, VectorType, MatrixType, Norm>::visitCycles(Visitor visitor, const CycleSearchOptions& options)
+        {
+            CycleVisitor<Visitor> cycleVisitor(*this, visitor);
+
+            return findCycles(options, false, cycleVisitor);
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename Coder>
+        std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> NumberSystem<ElementType, VectorType, MatrixType, Norm>::getCycles(const CycleSearchOptions& options, const Coder& coder)
+        {
+            CycleCollector collector(*this);
+            findCycles(options, false, collector, coder);
 
+            return collector.result;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename Coder>
+        std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> NumberSystem<ElementType, VectorType, MatrixType, Norm>::resumeCycles(const CycleSearchOptions& options, const Coder& coder)
+        {
+            CycleCollector collector(*this);
+            findCycles(options, true, collector, coder);
+
+            return collector.result;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename Visitor, typename Coder>
+        bool NumberSystem<ElementType, VectorType, MatrixType, Norm>::visitCycles(Visitor visitor, const CycleSearchOptions& options, const Coder& coder)
+        {
+            CycleVisitor<Visitor> cycleVisitor(*this, visitor);
+
+            return findCycles(options, false, cycleVisitor, coder);
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename CycleHandler>
+        bool NumberSystem<ElementType, VectorType, MatrixType, Norm>::findCycles(const CycleSearchOptions& options, bool resume, CycleHandler& handler)
+        {
             std::vector<int> lowerBound, upperBound;
             Traits::getBounds(props.getInverse(), digitSet, lowerBound, upperBound);
 
-            VectorCoder coder(lowerBound, upperBound);
+            return findCycles(options, resume, handler, VectorCoder(lowerBound, upperBound));
+        }
 
-            GeNuSys::LinAlg::Vector<ElementType> Uz = hash.createCache();
-            GeNuSys::LinAlg::Vector<ElementType> act[2] = { GeNuSys::LinAlg::Vector<ElementType>(N), GeNuSys::LinAlg::Vector<ElementType>(N) };
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename CycleHandler, typename Coder>
+        bool NumberSystem<ElementType, VectorType, MatrixType, Norm>::findCycles(const CycleSearchOptions& options, bool resume, CycleHandler& handler, const Coder& coder)
+        {
+            CycleCheckpoint checkpoint;
+            checkpoint.lowerBound = coder.getLowerBound();
+            checkpoint.upperBound = coder.getUpperBound();
+            checkpoint.fingerprint = getFingerprint(options, coder);
+            if (resume)
+            {
+                CycleCheckpoint expected = checkpoint;
+                checkpoint.load(options.checkpointFile);
+                if (checkpoint.lowerBound != expected.lowerBound || checkpoint.upperBound != expected.upperBound || checkpoint.fingerprint != expected.fingerprint)
+                {
+                    throw std::runtime_error{"Checkpoint " + options.checkpointFile + " belongs to another number system or search"};
+                }
+            }
 
-            std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> result;
+            // A finished search is not resumed. The steppers start at the first point of the domain, so an empty
+            // domain is finished without a scan.
+            bool completed = true;
+            if (coder.getSize() == 0)
+            {
+                std::vector<std::vector<unsigned long long>> cycles;
+                handler.finished(coder, cycles);
+            }
+            else
+            {
+                completed = dispatchScan(options, resume, handler, coder, checkpoint, std::is_same<ElementType, long long>());
+            }
+            if (completed && !options.checkpointFile.empty())
+            {
+                std::remove(options.checkpointFile.c_str());
+            }
 
-            BitVector touched(coder.getSize());
-            std::vector<unsigned long long> path;
-            unsigned long long coderSize = coder.getSize();
+            return completed;
+        }
 
-#ifndef GENUSYS_NO_THREADING
-            uint32_t threadCount = thread_count::get();
-            if(threadCount > 1)
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename Coder>
+        unsigned long long NumberSystem<ElementType, VectorType, MatrixType, Norm>::getFingerprint(const CycleSearchOptions& options, const Coder& coder) const
+        {
+            unsigned long long fingerprint = 0xcbf29ce484222325ULL;
+
+            // The entries are added in base 2^16 digits, so that any integral element type can be hashed
+            const ElementType radix = ElementType(1 << 16);
+            auto mixElement = [&fingerprint, &radix](ElementType value)
             {
-                std::vector<std::thread> workers;
-                unsigned long long threadSize = coderSize/threadCount;
-                std::mutex result_mut;
-                for(uint32_t m = 0; m < threadCount; ++m)
+                while (value != ElementTraits<ElementType>::zero() && value != -ElementTraits<ElementType>::one())
                 {
-                    workers.push_back(std::thread([N,m,&touched,&coder,&result,&result_mut,coderSize,threadSize,threadCount,this]()
-                    {
-                                    std::vector<unsigned long long> path;
-                                    GeNuSys::LinAlg::Vector<ElementType> Uz = hash.createCache();
-                                    GeNuSys::LinAlg::Vector<ElementType> act[2] = { GeNuSys::LinAlg::Vector<ElementType>(N), GeNuSys::LinAlg::Vector<ElementType>(N) };
-                                    const unsigned long long start = m * threadSize;
-                                    const unsigned long long end = ((m == threadCount - 1) ? coderSize : start + threadSize);
-                for (unsigned long long i = start; i < end; ++i)
+                    ElementType digit = ElementTraits<ElementType>::mod(value, radix);
+                    CycleCheckpoint::mix(fingerprint, ElementTraits<ElementType>::template asTypeUnsafe<int>(digit));
+                    value = ElementTraits<ElementType>::idiv(value - digit, radix);
+                }
+                CycleCheckpoint::mix(fingerprint, value == ElementTraits<ElementType>::zero() ? 0 : 1);
+            };
+
+            const unsigned int N = props.getBase().getRows();
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    mixElement(props.getBase()(i, j));
+                }
+            }
+            CycleCheckpoint::mix(fingerprint, digitSet.size());
+            for (unsigned int d = 0; d < digitSet.size(); ++d)
+            {
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    mixElement(digitSet[d][j]);
+                }
+            }
+
+            const std::string coderType = typeid(Coder).name();
+            for (unsigned int i = 0; i < coderType.size(); ++i)
+            {
+                CycleCheckpoint::mix(fingerprint, (unsigned char) coderType[i]);
+            }
+            CycleCheckpoint::mix(fingerprint, coder.getSize());
+            CycleCheckpoint::mix(fingerprint, options.sieveStartPoints);
+            CycleCheckpoint::mix(fingerprint, options.boundedMemory);
+
+            return fingerprint;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename CycleHandler, typename Coder>
+        bool NumberSystem<ElementType, VectorType, MatrixType, Norm>::dispatchScan(const CycleSearchOptions& options, bool resume, CycleHandler& handler,
+                const Coder& coder, CycleCheckpoint& checkpoint, std::false_type)
+        {
+            return scanCycles(options, resume, handler, coder, checkpoint, PhiStepper<Coder>(*this, coder));
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename CycleHandler, typename Coder>
+        bool NumberSystem<ElementType, VectorType, MatrixType, Norm>::dispatchScan(const CycleSearchOptions& options, bool resume, CycleHandler& handler,
+                const Coder& coder, CycleCheckpoint& checkpoint, std::true_type)
+        {
+            return dispatchScan(options, resume, handler, coder, checkpoint, std::integral_constant<unsigned int, GENUSYS_FIXED_PHI_MAX_DIM>());
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename CycleHandler, typename Coder, unsigned int D>
+        bool NumberSystem<ElementType, VectorType, MatrixType, Norm>::dispatchScan(const CycleSearchOptions& options, bool resume, CycleHandler& handler,
+                const Coder& coder, CycleCheckpoint& checkpoint, std::integral_constant<unsigned int, D>)
+        {
+            if (props.getBase().getRows() == D)
+            {
+                FixedPhi<D> fixedPhi(props, hash, digitSet, coder.getBox());
+                if (fixedPhi.isComplete())
                 {
-                    if (touched[i])
+#ifndef GENUSYS_NO_THREADING
+                    // A Brent walk follows a single orbit
+                    if (!options.boundedMemory)
                     {
-                        continue;
+                        return scanCycles(options, resume, handler, coder, checkpoint, typename FixedPhi<D>::template Stepper<GENUSYS_FIXED_PHI_LANES, Coder>(fixedPhi, coder));
                     }
+#endif
+                    return scanCycles(options, resume, handler, coder, checkpoint, typename FixedPhi<D>::template Stepper<1, Coder>(fixedPhi, coder));
+                }
 
-                    path.clear();
+                return dispatchScan(options, resume, handler, coder, checkpoint, std::false_type());
+            }
 
-                    coder.decode(i, act[0]);
+            return dispatchScan(options, resume, handler, coder, checkpoint, std::integral_constant<unsigned int, D - 1>());
+        }
 
-                    unsigned long long idx = i;
-                    path.push_back(idx);
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename CycleHandler, typename Coder>
+        bool NumberSystem<ElementType, VectorType, MatrixType, Norm>::dispatchScan(const CycleSearchOptions& options, bool resume, CycleHandler& handler,
+                const Coder& coder, CycleCheckpoint& checkpoint, std::integral_constant<unsigned int, 0>)
+        {
+            return dispatchScan(options, resume, handler, coder, checkpoint, std::false_type());
+        }
 
-                    bool valid = true;
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        bool NumberSystem<ElementType, VectorType, MatrixType, Norm>::phiMightOverflow(const VectorCoder& box, std::true_type) const
+        {
+            return !phiFitsLongLong(props, hash, digitSet, box);
+        }
 
-                    int actIdx = 0;
-                    do
-                    {
-                        touched.set(idx);
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        bool NumberSystem<ElementType, VectorType, MatrixType, Norm>::phiMightOverflow(const VectorCoder&, std::false_type) const
+        {
+            return false;
+        }
 
-                        phi(act[actIdx], act[(actIdx + 1) % 2], Uz);
-                        actIdx = (actIdx + 1) % 2;
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        void NumberSystem<ElementType, VectorType, MatrixType, Norm>::stepChecked(const GeNuSys::LinAlg::Vector<ElementType>& z,
+                GeNuSys::LinAlg::Vector<ElementType>& phiZ, const VectorCoder& box, std::true_type) const
+        {
+            const unsigned int n = z.getLength();
+            bool fits = true;
 
-                        idx = coder.encode(act[actIdx], valid);
+            long long idx = 0;
+            for (unsigned int i = 0; i < hash.getSize() && fits; ++i)
+            {
+                long long Uz = 0;
+                for (unsigned int j = 0; j < n && fits; ++j)
+                {
+                    long long product;
+                    fits = !__builtin_mul_overflow(hash.getU()(i, j), z[j], &product) && !__builtin_add_overflow(Uz, product, &Uz);
+                }
+                idx += ElementTraits<long long>::mod(Uz, hash.getG()[i]) * hash.getProdG()[i];
+            }
 
-                        path.push_back(idx);
-                    }
-                    while (valid && !touched[idx]);
+            if (fits && !hashTable.hasDigit(idx))
+            {
+                throw std::logic_error{"No digit is congruent to the point, the digit set is not a complete residue system"};
+            }
+            std::vector<long long> diff(n);
+            for (unsigned int j = 0; j < n && fits; ++j)
+            {
+                fits = !__builtin_sub_overflow(z[j], hashTable.getDigitRow(idx)[j], &diff[j]);
+            }
+
+            for (unsigned int i = 0; i < n && fits; ++i)
+            {
+                long long adjDiff = 0;
+                for (unsigned int j = 0; j < n && fits; ++j)
+                {
+                    long long product;
+                    fits = !__builtin_mul_overflow(props.getAdjoint()(i, j), diff[j], &product) && !__builtin_add_overflow(adjDiff, product, &adjDiff);
+                }
+                phiZ.set(i, props.getDetDivider().exactQuotient(adjDiff));
+            }
+            if (fits)
+            {
+                return;
+            }
+
+            // The same step in mpz_class
+            std::vector<mpz_class> exactZ(n);
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                exactZ[j] = ElementTraits<long long>::asType<mpz_class>(z[j]);
+            }
+
+            unsigned long long exactIdx = 0;
+            for (unsigned int i = 0; i < hash.getSize(); ++i)
+            {
+                mpz_class Uz = 0;
+                for (unsigned int j = 0; j < n; ++j)
+                {
+                    Uz += ElementTraits<long long>::asType<mpz_class>(hash.getU()(i, j)) * exactZ[j];
+                }
+                mpz_class residue = ElementTraits<mpz_class>::mod(Uz, ElementTraits<long long>::asType<mpz_class>(hash.getG()[i]));
+                exactIdx += residue.get_ui() * hash.getProdG()[i];
+            }
+            if (!hashTable.hasDigit(exactIdx))
+            {
+                throw std::logic_error{"No digit is congruent to the point, the digit set is not a complete residue system"};
+            }
+
+            std::vector<mpz_class> exactDiff(n);
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                exactDiff[j] = exactZ[j] - ElementTraits<long long>::asType<mpz_class>(hashTable.getDigitRow(exactIdx)[j]);
+            }
+
+            const mpz_class det = ElementTraits<long long>::asType<mpz_class>(props.getDetDivider().getDivisor());
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                mpz_class adjDiff = 0;
+                for (unsigned int j = 0; j < n; ++j)
+                {
+                    adjDiff += ElementTraits<long long>::asType<mpz_class>(props.getAdjoint()(i, j)) * exactDiff[j];
+                }
+                mpz_class exactImage = ElementTraits<mpz_class>::idiv(adjDiff, det);
+                if (exactImage < (long) box.getLowerBound()[i])
+                {
+                    phiZ.set(i, box.getLowerBound()[i] - 1);
+                }
+                else if (exactImage > (long) box.getUpperBound()[i])
+                {
+                    phiZ.set(i, box.getUpperBound()[i] + 1);
+                }
+                else
+                {
+                    phiZ.set(i, exactImage.get_si());
+                }
+            }
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        void NumberSystem<ElementType, VectorType, MatrixType, Norm>::stepChecked(const GeNuSys::LinAlg::Vector<ElementType>& z,
+                GeNuSys::LinAlg::Vector<ElementType>& phiZ, const VectorCoder&, std::false_type) const
+        {
+            phiZ = phi(z);
+        }
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename CycleHandler, typename Coder, typename Stepper>
+        bool NumberSystem<ElementType, VectorType, MatrixType, Norm>::scanCycles(const CycleSearchOptions& options, bool resume, CycleHandler& handler,
+                const Coder& coder, CycleCheckpoint& checkpoint, const Stepper& prototype)
+        {
+            if (options.boundedMemory)
+            {
+                return scanCyclesBounded(options, resume, handler, coder, checkpoint, prototype);
+            }
+
+            std::vector<std::vector<unsigned long long>> cycles = checkpoint.cycles;
+
+            unsigned long long coderSize = coder.getSize();
+
+            // The scan is saved at the first start point after the deadline passed
+            const bool checkpointing = !options.checkpointFile.empty();
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(options.checkpointInterval);
+
+            // Points which are not periodic are not walked, an orbit running into one of them still visits it. Every
+            // walker queries its own copy of the sieve, which is only built if it is used.
+            std::unique_ptr<const AttractorSieve> sieve(options.sieveStartPoints ? new AttractorSieve(props, digitSet, coder.getBox()) : 0);
+
+#ifndef GENUSYS_NO_THREADING
+            uint32_t threadCount = std::max<uint32_t>(thread_count::get(), 1);
+            if (threadCount > 1 || Stepper::lanes > 1)
+            {
+                // Concurrent walks, either on several threads or on the lanes of a stepper, share the search
+                // space by claiming and settling points, see OrbitWalk. That takes two bits per point, twice the
+                // visited set of the serial scan, and a second file if the visited set is file backed.
+                AtomicBitVector claimed(coderSize, options.visitedSetFile);
+                AtomicBitVector settled(coderSize, options.visitedSetFile.empty() ? std::string() : options.visitedSetFile + ".settled");
+
+                std::unique_ptr<RangeScheduler> scheduler;
+                if (resume)
+                {
+                    checkpoint.loadVisited(options.checkpointFile, claimed);
+                    checkpoint.loadVisited(options.checkpointFile, settled);
+                    scheduler.reset(new RangeScheduler(checkpoint.ranges, threadCount, grain_size::get()));
+                }
+                else
+                {
+                    scheduler.reset(new RangeScheduler(coderSize, threadCount, grain_size::get()));
+                }
+
+                std::mutex result_mut;
+                std::atomic<bool> stopped(false);
 
-                    if (!valid)
+                // Every lane of the stepper walks its own orbit, idle lanes take the next unclaimed start point of the chunk.
+                // Once the deadline passed no more chunks are taken (but at least one), and the worker returns when its
+                // walks are over.
+                auto work = [checkpointing, &sieve, &deadline, &prototype, &claimed, &settled, &coder, &cycles, &result_mut, &scheduler, &stopped, &handler](uint32_t m)
+                {
+                    Stepper stepper(prototype);
+                    std::unique_ptr<AttractorSieve> sieved(sieve ? new AttractorSieve(*sieve) : 0);
+                    OrbitWalk walks[Stepper::lanes];
+                    bool active[Stepper::lanes];
+                    unsigned long long codes[Stepper::lanes];
+                    bool valid[Stepper::lanes];
+                    unsigned int activeCount = 0;
+                    for (unsigned int l = 0; l < Stepper::lanes; ++l)
                     {
-                        continue;
+                        active[l] = false;
                     }
 
-                    for (int j = path.size() - 2; j >= 0; --j)
+                    unsigned long long next = 0, chunkEnd = 0;
+                    bool fetching = true, fetched = false;
+                    while (!stopped.load(std::memory_order_relaxed))
                     {
-                        if (path[j] == path[path.size() - 1])
+                        for (unsigned int l = 0; l < Stepper::lanes && fetching; ++l)
                         {
-                            std::vector<GeNuSys::LinAlg::Vector<ElementType>> loop;
-                            GeNuSys::LinAlg::Vector<ElementType> vct(N);
-                            for (unsigned int k = j; k < path.size(); ++k)
+                            while (!active[l])
                             {
-                                coder.decode(path[k], vct);
-                                loop.push_back(vct);
-                            }
+                                if (next == chunkEnd)
+                                {
+                                    if ((fetched && checkpointing && std::chrono::steady_clock::now() >= deadline) || !scheduler->next(m, next, chunkEnd))
+                                    {
+                                        fetching = false;
+                                        break;
+                                    }
+                                    fetched = true;
+                                    claimed.prefetch(next, chunkEnd);
+                                    continue;
+                                }
 
-                            std::lock_guard<std::mutex> res_guard(result_mut);
-                            result.push_back(loop);
+                                unsigned long long i = next++;
+                                if ((sieved && (*sieved)(coder.toBox(i))) || claimed[i] || claimed.testAndSet(i))
+                                {
+                                    continue;
+                                }
+                                walks[l].begin(i);
+                                stepper.load(l, i);
+                                active[l] = true;
+                                ++activeCount;
+                            }
+                        }
 
+                        if (activeCount == 0)
+                        {
                             break;
                         }
+
+                        stepper.step(codes, valid);
+
+                        for (unsigned int l = 0; l < Stepper::lanes; ++l)
+                        {
+                            if (!active[l] || walks[l].visit(codes[l], valid[l], claimed, settled))
+                            {
+                                continue;
+                            }
+                            active[l] = false;
+                            --activeCount;
+
+                            const std::vector<unsigned long long>& path = walks[l].path;
+                            if (walks[l].loopStart >= 0)
+                            {
+                                // Several walks may close the same cycle, only the first one reports it
+                                std::lock_guard<std::mutex> res_guard(result_mut);
+                                if (!settled[path[walks[l].loopStart]] && !stopped.load(std::memory_order_relaxed))
+                                {
+                                    cycles.push_back(std::vector<unsigned long long>(path.begin() + walks[l].loopStart, path.end() - 1));
+                                    if (!handler.found(coder, cycles.back()))
+                                    {
+                                        stopped.store(true, std::memory_order_relaxed);
+                                    }
+                                    for (unsigned int k = walks[l].loopStart; k < path.size(); ++k)
+                                    {
+                                        settled.set(path[k]);
+                                    }
+                                }
+                            }
+
+                            for (unsigned int k = 0; k < path.size(); ++k)
+                            {
+                                settled.set(path[k]);
+                            }
+                        }
                     }
-                }
-                    }));
-                }
+                };
 
-                for(auto& w: workers)
+                // Workers stop once the deadline passed. Then every claimed point is settled, so the
+                // visited set and the remaining ranges are saved and the workers restarted. Like the serial
+                // scan, a deadline which passed before the first round saves the scan before any walk.
+                while (true)
                 {
-                    w.join();
+                    if (checkpointing && std::chrono::steady_clock::now() >= deadline)
+                    {
+                        checkpoint.ranges = scheduler->getRanges();
+                        checkpoint.cycles = cycles;
+                        checkpoint.save(options.checkpointFile, claimed);
+                        deadline = std::chrono::steady_clock::now() + std::chrono::seconds(options.checkpointInterval);
+                    }
+
+                    if (threadCount > 1)
+                    {
+                        std::vector<std::thread> workers;
+                        for (uint32_t m = 0; m < threadCount; ++m)
+                        {
+                            workers.push_back(std::thread(work, m));
+                        }
+                        for (auto& w : workers)
+                        {
+                            w.join();
+                        }
+                    }
+                    else
+                    {
+                        work(0);
+                    }
+
+                    if (stopped)
+                    {
+                        return false;
+                    }
+
+                    if (scheduler->getRanges().empty())
+                    {
+                        break;
+                    }
                 }
-            } else
+            }
+            else
 #endif
             {
-                for (unsigned long long i = 0; i < coderSize; ++i)
+                Stepper stepper(prototype);
+                std::unique_ptr<AttractorSieve> sieved(sieve ? new AttractorSieve(*sieve) : 0);
+
+                BitVector touched(coderSize, options.visitedSetFile);
+                // Number of points of the visited set read ahead of the scan, if it is file backed
+                const unsigned long long prefetchWindow = 1ULL << 26;
+                std::vector<unsigned long long> path;
+
+                std::vector<std::pair<unsigned long long, unsigned long long>> ranges(1, std::make_pair(0ULL, coderSize));
+                if (resume)
+                {
+                    checkpoint.loadVisited(options.checkpointFile, touched);
+                    ranges = checkpoint.ranges;
+                }
+
+                for (unsigned int r = 0; r < ranges.size(); ++r)
                 {
-                    if (touched[i])
+                    for (unsigned long long i = ranges[r].first; i < ranges[r].second; ++i)
                     {
-                        continue;
-                    }
+                        if ((i - ranges[r].first) % prefetchWindow == 0)
+                        {
+                            touched.prefetch(i, i + prefetchWindow);
+                        }
 
-                    path.clear();
+                        if (checkpointing && i % 4096 == 0 && std::chrono::steady_clock::now() >= deadline)
+                        {
+                            checkpoint.ranges.assign(1, std::make_pair(i, ranges[r].second));
+                            checkpoint.ranges.insert(checkpoint.ranges.end(), ranges.begin() + r + 1, ranges.end());
+                            checkpoint.cycles = cycles;
+                            checkpoint.save(options.checkpointFile, touched);
+                            deadline = std::chrono::steady_clock::now() + std::chrono::seconds(options.checkpointInterval);
+                        }
 
-                    coder.decode(i, act[0]);
+                        if (touched[i] || (sieved && (*sieved)(coder.toBox(i))))
+                        {
+                            continue;
+                        }
 
-                    unsigned long long idx = i;
-                    path.push_back(idx);
+                        path.clear();
 
-                    bool valid = true;
+                        stepper.load(0, i);
 
-                    int actIdx = 0;
-                    do
-                    {
-                        touched.set(idx);
+                        unsigned long long idx = i;
+                        path.push_back(idx);
 
-                        phi(act[actIdx], act[(actIdx + 1) % 2], Uz);
-                        actIdx = (actIdx + 1) % 2;
+                        bool valid = true;
 
-                        idx = coder.encode(act[actIdx], valid);
+                        do
+                        {
+                            touched.set(idx);
 
-                        path.push_back(idx);
+                            stepper.step(&idx, &valid);
+
+                            path.push_back(idx);
+                        }
+                        while (valid && !touched[idx]);
+
+                        if (!valid)
+                        {
+                            continue;
+                        }
+
+                        for (int j = path.size() - 2; j >= 0; --j)
+                        {
+                            if (path[j] == path[path.size() - 1])
+                            {
+                                cycles.push_back(std::vector<unsigned long long>(path.begin() + j, path.end() - 1));
+                                if (!handler.found(coder, cycles.back()))
+                                {
+                                    return false;
+                                }
+
+                                break;
+                            }
+                        }
                     }
-                    while (valid && !touched[idx]);
+                }
+            }
+
+            handler.finished(coder, cycles);
+
+            return true;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename CycleHandler, typename Coder, typename Stepper>
+        bool NumberSystem<ElementType, VectorType, MatrixType, Norm>::scanCyclesBounded(const CycleSearchOptions& options, bool resume, CycleHandler& handler,
+                const Coder& coder, CycleCheckpoint& checkpoint, const Stepper& prototype)
+        {
+            std::vector<std::vector<unsigned long long>> cycles = checkpoint.cycles;
+
+            // The smallest code of every reported cycle
+            std::unordered_set<unsigned long long> representatives;
+            for (unsigned int c = 0; c < cycles.size(); ++c)
+            {
+                representatives.insert(*std::min_element(cycles[c].begin(), cycles[c].end()));
+            }
+
+            BitVector noVisited(0);
+            std::vector<std::pair<unsigned long long, unsigned long long>> ranges(1, std::make_pair(0ULL, coder.getSize()));
+            if (resume)
+            {
+                checkpoint.loadVisited(options.checkpointFile, noVisited);
+                ranges = checkpoint.ranges;
+            }
+
+            const bool checkpointing = !options.checkpointFile.empty();
+            std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(options.checkpointInterval);
+
+            std::unique_ptr<const AttractorSieve> sieve(options.sieveStartPoints ? new AttractorSieve(props, digitSet, coder.getBox()) : 0);
+
+#ifndef GENUSYS_NO_THREADING
+            std::mutex result_mut;
+            std::atomic<bool> stopped(false);
+#else
+            bool stopped = false;
+#endif
 
-                    if (!valid)
+            // Walks the start points in [begin, end), sieved is null if the start points are not sieved. Every walker
+            // keeps its own copy of the reported cycles, it catches up with the others whenever it finds a cycle.
+            auto process = [&coder, &cycles, &representatives, &stopped, &handler
+#ifndef GENUSYS_NO_THREADING
+                            , &result_mut
+#endif
+                           ](Stepper& stepper, AttractorSieve* sieved, BrentWalk& brent, unsigned int& known, unsigned long long begin, unsigned long long end)
+            {
+                for (unsigned long long i = begin; i < end && !stopped; ++i)
+                {
+                    if ((sieved && (*sieved)(coder.toBox(i))) || brent.isResolved(i) || !brent.walk(stepper, i))
                     {
                         continue;
                     }
 
-                    for (int j = path.size() - 2; j >= 0; --j)
+#ifndef GENUSYS_NO_THREADING
+                    std::lock_guard<std::mutex> res_guard(result_mut);
+#endif
+                    if (representatives.insert(*std::min_element(brent.cycle.begin(), brent.cycle.end())).second)
                     {
-                        if (path[j] == path[path.size() - 1])
+                        cycles.push_back(brent.cycle);
+                        if (!handler.found(coder, cycles.back()))
                         {
-                            std::vector<GeNuSys::LinAlg::Vector<ElementType>> loop;
-                            GeNuSys::LinAlg::Vector<ElementType> vct(N);
-                            for (unsigned int k = j; k < path.size(); ++k)
-                            {
-                                coder.decode(path[k], vct);
-                                loop.push_back(vct);
-                            }
+                            stopped = true;
+                        }
+                    }
+                    for (; known < cycles.size(); ++known)
+                    {
+                        brent.addCycle(cycles[known]);
+                    }
+                }
+            };
 
-                            result.push_back(loop);
+#ifndef GENUSYS_NO_THREADING
+            uint32_t threadCount = std::max<uint32_t>(thread_count::get(), 1);
+            RangeScheduler scheduler(ranges, threadCount, grain_size::get());
 
-                            break;
-                        }
+            std::vector<BrentWalk> walkers(threadCount);
+            std::vector<unsigned int> known(threadCount, cycles.size());
+            for (uint32_t m = 0; m < threadCount; ++m)
+            {
+                for (unsigned int c = 0; c < cycles.size(); ++c)
+                {
+                    walkers[m].addCycle(cycles[c]);
+                }
+            }
+
+            // Once the deadline passed no more chunks are taken (but at least one)
+            auto work = [checkpointing, &deadline, &prototype, &sieve, &scheduler, &walkers, &known, &stopped, &process](uint32_t m)
+            {
+                Stepper stepper(prototype);
+                std::unique_ptr<AttractorSieve> sieved(sieve ? new AttractorSieve(*sieve) : 0);
+                unsigned long long begin, end;
+                bool fetched = false;
+                while (!stopped && !(fetched && checkpointing && std::chrono::steady_clock::now() >= deadline) && scheduler.next(m, begin, end))
+                {
+                    fetched = true;
+                    process(stepper, sieved.get(), walkers[m], known[m], begin, end);
+                }
+            };
+
+            while (true)
+            {
+                if (threadCount > 1)
+                {
+                    std::vector<std::thread> workers;
+                    for (uint32_t m = 0; m < threadCount; ++m)
+                    {
+                        workers.push_back(std::thread(work, m));
+                    }
+                    for (auto& w : workers)
+                    {
+                        w.join();
+                    }
+                }
+                else
+                {
+                    work(0);
+                }
+
+                if (stopped)
+                {
+                    return false;
+                }
+
+                checkpoint.ranges = scheduler.getRanges();
+                if (checkpoint.ranges.empty())
+                {
+                    break;
+                }
+                checkpoint.cycles = cycles;
+                checkpoint.save(options.checkpointFile, noVisited);
+                deadline = std::chrono::steady_clock::now() + std::chrono::seconds(options.checkpointInterval);
+            }
+#else
+            Stepper stepper(prototype);
+            std::unique_ptr<AttractorSieve> sieved(sieve ? new AttractorSieve(*sieve) : 0);
+            BrentWalk brent;
+            unsigned int known = cycles.size();
+            for (unsigned int c = 0; c < cycles.size(); ++c)
+            {
+                brent.addCycle(cycles[c]);
+            }
+
+            const unsigned long long chunkSize = 4096;
+            for (unsigned int r = 0; r < ranges.size(); ++r)
+            {
+                for (unsigned long long i = ranges[r].first; i < ranges[r].second; i += std::min(chunkSize, ranges[r].second - i))
+                {
+                    if (checkpointing && std::chrono::steady_clock::now() >= deadline)
+                    {
+                        checkpoint.ranges.assign(1, std::make_pair(i, ranges[r].second));
+                        checkpoint.ranges.insert(checkpoint.ranges.end(), ranges.begin() + r + 1, ranges.end());
+                        checkpoint.cycles = cycles;
+                        checkpoint.save(options.checkpointFile, noVisited);
+                        deadline = std::chrono::steady_clock::now() + std::chrono::seconds(options.checkpointInterval);
+                    }
+
+                    process(stepper, sieved.get(), brent, known, i, i + std::min(chunkSize, ranges[r].second - i));
+                    if (stopped)
+                    {
+                        return false;
                     }
                 }
             }
+#endif
+
+            handler.finished(coder, cycles);
+
+            return true;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename Coder>
+        std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> NumberSystem<ElementType, VectorType, MatrixType, Norm>::decodeCycles(const Coder& coder,
+                std::vector<std::vector<unsigned long long>>& cycles) const
+        {
+            // Rotate every cycle so that it starts with its smallest code, then sort and drop duplicates.
+            // This makes the result independent of the scan order, and hence of the number of threads.
+            for (unsigned int i = 0; i < cycles.size(); ++i)
+            {
+                std::rotate(cycles[i].begin(), std::min_element(cycles[i].begin(), cycles[i].end()), cycles[i].end());
+            }
+            std::sort(cycles.begin(), cycles.end());
+            cycles.erase(std::unique(cycles.begin(), cycles.end()), cycles.end());
+
+            std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> result;
+            for (unsigned int i = 0; i < cycles.size(); ++i)
+            {
+                result.push_back(decodeCycle(coder, cycles[i]));
+            }
+
+            return result;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType,
+            template<typename> class MatrixType,
+            typename Norm
+            >
+        template <typename Coder>
+        std::vector<GeNuSys::LinAlg::Vector<ElementType>> NumberSystem<ElementType, VectorType, MatrixType, Norm>::decodeCycle(const Coder& coder, std::vector<unsigned long long> cycle) const
+        {
+            std::rotate(cycle.begin(), std::min_element(cycle.begin(), cycle.end()), cycle.end());
+
+            std::vector<GeNuSys::LinAlg::Vector<ElementType>> result;
+            GeNuSys::LinAlg::Vector<ElementType> vct(props.getBase().getRows());
+            for (unsigned int k = 0; k < cycle.size(); ++k)
+            {
+                coder.decode(cycle[k], vct);
+                result.push_back(vct);
+            }
+            coder.decode(cycle[0], vct);
+            result.push_back(vct);
 
             return result;
         }
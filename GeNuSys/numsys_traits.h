@@ -32,6 +32,30 @@ namespace GeNuSys
     namespace NumSys
     {
 
+        // Parameters of Traits::findBasisTransformation. The same options give the same transformation, regardless of
+        // the number of threads.
+        struct BasisSearchOptions
+        {
+            // Number of candidates kept in every generation, at least 1
+            unsigned int candidates;
+
+            // Number of mutations of every candidate in a generation, at least 1
+            unsigned int mutations;
+
+            // The search stops after this many generations without improvement
+            unsigned int noImprovementLimit;
+
+            // Seed of the random number generator choosing the mutations
+            unsigned int seed;
+
+            // Start the search from Traits::reduceBasis instead of the identity, if it has a smaller volume
+            bool reduceLattice;
+
+            bool deepInsertions;
+
+            BasisSearchOptions(): candidates(15), mutations(5), noImprovementLimit(2), seed(5489), reduceLattice(false), deepInsertions(false) {}
+        };
+
         struct Traits
         {
 
@@ -50,6 +74,16 @@ namespace GeNuSys
             static void getBounds(const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& invM, const std::vector<VectorType<ElementType>>& digitSet,
                                   std::vector<int>& lowerBound, std::vector<int>& upperBound);
 
+            // Computes lower[r] <= (directions * z)[r] <= upper[r] for the periodic points z, i.e. an enclosing polytope
+            // of the attractor with the rows of directions as facet normals. getBounds is the case directions = T.
+            template <
+                typename ElementType,
+                template<typename> class VectorType
+                >
+            static void getEnclosure(const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& invM, const std::vector<VectorType<ElementType>>& digitSet,
+                                     const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& directions,
+                                     std::vector<typename ElementTraits<ElementType>::RationalType>& lower, std::vector<typename ElementTraits<ElementType>::RationalType>& upper);
+
             template <
                 typename ElementType,
                 template<typename> class VectorType
@@ -63,6 +97,26 @@ namespace GeNuSys
             static unsigned long long getVolume(const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& invM, const std::vector<VectorType<ElementType>>& digitSet,
                                                 const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& T);
 
+            template <
+                typename ElementType,
+                template<typename> class VectorType
+                >
+            static GeNuSys::LinAlg::Matrix<ElementType> findBasisTransformation(
+                const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& invM, const std::vector<VectorType<ElementType>>& digitSet,
+                const BasisSearchOptions& options = BasisSearchOptions());
+
+            // Deterministic basis transformation: LLL reduces the rows of T for the quadratic form sum(invM^k * digit * digit^T * invM^k^T)
+            // of the attractor, so the rows of T, the normals of the faces of the box, are short in the directions in which the attractor
+            // is wide
+            template <
+                typename ElementType,
+                template<typename> class VectorType
+                >
+            static GeNuSys::LinAlg::Matrix<ElementType> reduceBasis(
+                const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& invM, const std::vector<VectorType<ElementType>>& digitSet,
+                bool deepInsertions = false);
+
+            // Same as findBasisTransformation with the given parameters, seeded by rand()
             template <
                 typename ElementType,
                 template<typename> class VectorType
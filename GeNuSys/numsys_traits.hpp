@@ -18,12 +18,136 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <vector>
+#include <deque>
+#include <random>
+#include <unordered_map>
+#include <type_traits>
+#include <stdexcept>
+
+#include "sparse_matrix.h"
+#include "linalg_algorithms.h"
+#include "threading.h"
+
+#ifndef GENUSYS_NO_THREADING
+#include <thread>
+#include <atomic>
+#include <mutex>
+#endif
 
 namespace GeNuSys
 {
     namespace NumSys
     {
 
+        // The series of Traits::getBounds in integers: with L = |scale|, base = A / L for an integer matrix A, the powers
+        // of the base are A^k / L^k and the partial sums are kept as integers over L^k, so unlike in rational arithmetic
+        // no fraction has to be reduced in the loop. The bounds are the same as those of the rational computation.
+        // Returns false if base * scale or the digits are not integral.
+        template <
+            typename ElementType,
+            typename DigitVectorType
+            >
+        bool getScaledBounds(const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& base,
+                             const typename ElementTraits<ElementType>::RationalType& scale, const std::vector<DigitVectorType>& digits,
+                             std::vector<int>& lowerBound, std::vector<int>& upperBound)
+        {
+            typedef typename ElementTraits<ElementType>::RationalType RationalType;
+            typedef typename GeNuSys::LinAlg::PNorm<00>::template NormType<RationalType>::Type NormType;
+
+            const unsigned int N = base.getRows();
+            const unsigned int D = digits.size();
+
+            const RationalType rationalL = (scale < ElementTraits<RationalType>::zero()) ? RationalType(-scale) : scale;
+            const ElementType L = ElementTraits<RationalType>::template asTypeUnsafe<ElementType>(rationalL);
+            if (ElementTraits<ElementType>::template asType<RationalType>(L) != rationalL || L == ElementTraits<ElementType>::zero())
+            {
+                return false;
+            }
+
+            GeNuSys::LinAlg::Matrix<ElementType> A(N, N);
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    RationalType value = base(i, j) * rationalL;
+                    A.set(i, j, ElementTraits<RationalType>::template asTypeUnsafe<ElementType>(value));
+                    if (ElementTraits<ElementType>::template asType<RationalType>(A(i, j)) != value)
+                    {
+                        return false;
+                    }
+                }
+            }
+            std::vector<ElementType> integerDigits(D * N);
+            for (unsigned int d = 0; d < D; ++d)
+            {
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    RationalType value = digits[d][j];
+                    integerDigits[d * N + j] = ElementTraits<RationalType>::template asTypeUnsafe<ElementType>(value);
+                    if (ElementTraits<ElementType>::template asType<RationalType>(integerDigits[d * N + j]) != value)
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            // The partial sums are low / denominator and high / denominator
+            std::vector<ElementType> low(N, ElementTraits<ElementType>::zero());
+            std::vector<ElementType> high(N, ElementTraits<ElementType>::zero());
+            ElementType denominator = ElementTraits<ElementType>::one();
+
+            // X = P[actIdx] / power
+            GeNuSys::LinAlg::Matrix<ElementType> P[2] = { A, GeNuSys::LinAlg::Matrix<ElementType>(N, N) };
+            ElementType power = L;
+
+            int actIdx = 0;
+            do
+            {
+                for (unsigned int i = 0; i < N; ++i)
+                {
+                    ElementType min, max;
+                    for (unsigned int d = 0; d < D; ++d)
+                    {
+                        ElementType product = ElementTraits<ElementType>::zero();
+                        for (unsigned int j = 0; j < N; ++j)
+                        {
+                            product += P[actIdx](i, j) * integerDigits[d * N + j];
+                        }
+                        if (d == 0 || product < min)
+                        {
+                            min = product;
+                        }
+                        if (d == 0 || product > max)
+                        {
+                            max = product;
+                        }
+                    }
+                    low[i] = low[i] * L + max;
+                    high[i] = high[i] * L + min;
+                }
+                denominator = power;
+                GeNuSys::LinAlg::Operations::mat_mul(A, P[actIdx], P[(actIdx + 1) % 2]);
+                actIdx = (actIdx + 1) % 2;
+                power *= L;
+            }
+            while (ElementTraits<NormType>::template asType<double>(ElementTraits<ElementType>::div(GeNuSys::LinAlg::PNorm<00>::norm(P[actIdx]), power)) > ElementTraits<double>::epsilon());
+
+            typename ElementTraits<NormType>::RationalType coef =
+                ElementTraits<NormType>::div(ElementTraits<NormType>::one(), ElementTraits<NormType>::one() - ElementTraits<ElementType>::div(GeNuSys::LinAlg::PNorm<00>::norm(P[actIdx]), power));
+
+            lowerBound = std::vector<int>(N);
+            upperBound = std::vector<int>(N);
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                RationalType lowSum = ElementTraits<ElementType>::div(low[i], denominator);
+                RationalType highSum = ElementTraits<ElementType>::div(high[i], denominator);
+                lowerBound[i] = ElementTraits<RationalType>::template asTypeUnsafe<int>(std::ceil(ElementTraits<RationalType>::template asTypeUnsafe<double>(-lowSum * coef)));
+                upperBound[i] = ElementTraits<RationalType>::template asTypeUnsafe<int>(std::floor(ElementTraits<RationalType>::template asTypeUnsafe<double>(-highSum * coef)));
+            }
+
+            return true;
+        }
+
         template <
             typename ElementType,
             template<typename> class VectorType
@@ -48,6 +172,15 @@ namespace GeNuSys
 
             GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType> base = T * invM * GeNuSys::LinAlg::Algorithms::invert(T);
 
+            // For an integer T, base * det(T) * det(M) is integral (M being the base of the number system), and the series
+            // can be summed in integers. Its denominators grow like det(M)^k, so machine integers sum it in their fraction-free type.
+            typedef typename std::conditional<std::is_floating_point<RationalType>::value, ElementType, typename FractionFreeType<ElementType>::Type>::type ScaledType;
+            if (!std::is_floating_point<RationalType>::value &&
+                getScaledBounds<ScaledType>(base, GeNuSys::LinAlg::Algorithms::det(T) / GeNuSys::LinAlg::Algorithms::det(invM), rationalDigits, lowerBound, upperBound))
+            {
+                return;
+            }
+
             std::vector<RationalType> low(N, 0);
             std::vector<RationalType> high(N, 0);
 
@@ -82,7 +215,8 @@ namespace GeNuSys
                 GeNuSys::LinAlg::Operations::mat_mul(base, X[actXIdx], X[(actXIdx + 1) % 2]);
                 actXIdx = (actXIdx + 1) % 2;
             }
-            while (GeNuSys::LinAlg::PNorm<00>::norm(X[actXIdx]) > ElementTraits<NormType>::epsilon());
+            // Compared as a double, rational types have no epsilon
+            while (ElementTraits<NormType>::template asType<double>(GeNuSys::LinAlg::PNorm<00>::norm(X[actXIdx])) > ElementTraits<double>::epsilon());
 
             typename ElementTraits<NormType>::RationalType coef =
                 ElementTraits<NormType>::div(ElementTraits<NormType>::one(), ElementTraits<NormType>::one() - GeNuSys::LinAlg::PNorm<00>::norm(X[actXIdx]));
@@ -107,6 +241,79 @@ namespace GeNuSys
             getBounds(invM, digitSet, GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>::identity(invM.getRows(), invM.getCols()), lowerBound, upperBound);
         }
 
+        template <
+            typename ElementType,
+            template<typename> class VectorType
+            >
+        void Traits::getEnclosure(const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& invM,
+                                  const std::vector<VectorType<ElementType>>& digitSet,
+                                  const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& directions,
+                                  std::vector<typename ElementTraits<ElementType>::RationalType>& lower, std::vector<typename ElementTraits<ElementType>::RationalType>& upper)
+        {
+
+            typedef typename ElementTraits<ElementType>::RationalType RationalType;
+            typedef typename GeNuSys::LinAlg::PNorm<00>::template NormType<RationalType>::Type NormType;
+
+            const unsigned int R = directions.getRows();
+
+            std::vector<VectorType<RationalType>> rationalDigits(digitSet.size());
+            for (unsigned int i = 0; i < digitSet.size(); ++i)
+            {
+                rationalDigits[i] = digitSet[i];
+            }
+
+            // A periodic point is -sum(invM^k * digit_k) for k >= 1, so the range of a direction v is the sum
+            // of the ranges of v * invM^k * digit, the tail is estimated as in getBounds
+            std::vector<RationalType> low(R, 0);
+            std::vector<RationalType> high(R, 0);
+
+            GeNuSys::LinAlg::Matrix<RationalType> X[2] = { directions * invM, directions };
+            GeNuSys::LinAlg::Matrix<RationalType> P[2] = { invM, invM };
+            std::vector<VectorType<RationalType>> multipliedDigits(digitSet.size(), VectorType<RationalType>(R));
+
+            int actIdx = 0;
+            do
+            {
+                for (unsigned int i = 0; i < rationalDigits.size(); ++i)
+                {
+                    GeNuSys::LinAlg::Operations::mat_mul(X[actIdx], rationalDigits[i], multipliedDigits[i]);
+                }
+                for (unsigned int r = 0; r < R; ++r)
+                {
+                    RationalType min = multipliedDigits[0][r];
+                    RationalType max = multipliedDigits[0][r];
+                    for (unsigned int j = 1; j < multipliedDigits.size(); ++j)
+                    {
+                        if (multipliedDigits[j][r] < min)
+                        {
+                            min = multipliedDigits[j][r];
+                        }
+                        if (multipliedDigits[j][r] > max)
+                        {
+                            max = multipliedDigits[j][r];
+                        }
+                    }
+                    low[r] += max;
+                    high[r] += min;
+                }
+                GeNuSys::LinAlg::Operations::mat_mul(X[actIdx], invM, X[(actIdx + 1) % 2]);
+                GeNuSys::LinAlg::Operations::mat_mul(P[actIdx], invM, P[(actIdx + 1) % 2]);
+                actIdx = (actIdx + 1) % 2;
+            }
+            while (ElementTraits<NormType>::template asType<double>(GeNuSys::LinAlg::PNorm<00>::norm(P[actIdx])) > ElementTraits<double>::epsilon());
+
+            typename ElementTraits<NormType>::RationalType coef =
+                ElementTraits<NormType>::div(ElementTraits<NormType>::one(), ElementTraits<NormType>::one() - GeNuSys::LinAlg::PNorm<00>::norm(P[actIdx]));
+
+            lower = std::vector<RationalType>(R);
+            upper = std::vector<RationalType>(R);
+            for (unsigned int r = 0; r < R; ++r)
+            {
+                lower[r] = -low[r] * coef;
+                upper[r] = -high[r] * coef;
+            }
+        }
+
         template <
             typename ElementType,
             template<typename> class VectorType
@@ -169,74 +376,285 @@ namespace GeNuSys
 
         };
 
+        // The volume of getVolume(invM, digitSet, T) for the candidates of findBasisTransformation. The powers of invM
+        // and their products with the digits do not depend on T, so they are computed once and shared by the candidates,
+        // which are near the identity and hence multiplied as sparse matrices. The volumes are memoized by T.
         template <
             typename ElementType,
             template<typename> class VectorType
             >
-        GeNuSys::LinAlg::Matrix<ElementType> Traits::findBasisTransformation(
-            const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& invM, const std::vector<VectorType<ElementType>>& digitSet,
-            const unsigned int candNum, const unsigned int mutateNum, const unsigned int noImprLimit)
+        class TransformationVolume
         {
-            typedef typename ElementTraits<ElementType>::RationalType RationalType;
 
-            const unsigned int N = invM.getRows();
+            private:
 
-            unsigned long long origVol = getVolume(invM, digitSet);
+                typedef typename ElementTraits<ElementType>::RationalType RationalType;
 
-            std::vector<Transformation<RationalType>> candidates(candNum, Transformation<RationalType>(GeNuSys::LinAlg::Matrix<RationalType>::identity(N, N), origVol));
+                typedef typename GeNuSys::LinAlg::PNorm<00>::template NormType<RationalType>::Type NormType;
 
-            unsigned int noImpr = 0;
-            while (noImpr < noImprLimit)
-            {
-                std::vector<Transformation<RationalType>> newCandidates;
-                for (unsigned int i = 0; i < candidates.size(); ++i)
+                struct KeyHash
                 {
-                    for (unsigned int j = 0; j < mutateNum; ++j)
+                    size_t operator()(const std::vector<long long>& key) const
                     {
-                        unsigned int x, y;
-                        do
+                        size_t h = 0;
+                        for (unsigned int i = 0; i < key.size(); ++i)
                         {
-                            x = rand() % N;
-                            y = rand() % N;
+                            h = h * 1000003 + std::hash<long long>()(key[i]);
                         }
-                        while (x == y);
 
-                        if (x > y)
+                        return h;
+                    }
+                };
+
+                const GeNuSys::LinAlg::Matrix<RationalType> invM;
+
+                std::vector<GeNuSys::LinAlg::Vector<RationalType>> digits;
+
+                // invM^(k + 1) and invM^(k + 1) * digits, references to the elements stay valid while they grow
+                std::deque<GeNuSys::LinAlg::Matrix<RationalType>> powers;
+
+                std::deque<std::vector<GeNuSys::LinAlg::Vector<RationalType>>> powerDigits;
+
+                std::unordered_map<std::vector<long long>, unsigned long long, KeyHash> volumes;
+
+#ifndef GENUSYS_NO_THREADING
+                std::mutex mut;
+#endif
+
+                void getPower(unsigned int k, const GeNuSys::LinAlg::Matrix<RationalType>*& power, const std::vector<GeNuSys::LinAlg::Vector<RationalType>>*& products)
+                {
+#ifndef GENUSYS_NO_THREADING
+                    std::lock_guard<std::mutex> guard(mut);
+#endif
+                    while (powers.size() < k)
+                    {
+                        powers.push_back(powers.empty() ? invM : invM * powers.back());
+                        powerDigits.push_back(std::vector<GeNuSys::LinAlg::Vector<RationalType>>(digits.size()));
+                        for (unsigned int d = 0; d < digits.size(); ++d)
                         {
-                            unsigned int t = x;
-                            x = y;
-                            y = t;
+                            powerDigits.back()[d] = powers.back() * digits[d];
                         }
+                    }
+                    power = &powers[k - 1];
+                    products = &powerDigits[k - 1];
+                }
+
+            public:
 
-                        GeNuSys::LinAlg::Matrix<RationalType> U = candidates[i].T;
-                        unsigned long long origVolU;
-                        unsigned long long volU = getVolume(invM, digitSet, U);
-                        do
+                TransformationVolume(const GeNuSys::LinAlg::Matrix<RationalType>& invM, const std::vector<VectorType<ElementType>>& digitSet): invM(invM), digits(digitSet.size())
+                {
+                    for (unsigned int d = 0; d < digitSet.size(); ++d)
+                    {
+                        digits[d] = digitSet[d];
+                    }
+                }
+
+                // Same as getVolume(invM, digitSet, T)
+                unsigned long long operator()(const GeNuSys::LinAlg::Matrix<RationalType>& T)
+                {
+                    const unsigned int N = invM.getRows();
+
+                    std::vector<long long> key(N * N);
+                    for (unsigned int i = 0; i < N; ++i)
+                    {
+                        for (unsigned int j = 0; j < N; ++j)
                         {
-                            origVolU = volU;
-                            U.set(x, y, U(x, y) + 1);
-                            volU = getVolume(invM, digitSet, U);
+                            key[i * N + j] = ElementTraits<RationalType>::template asTypeUnsafe<long long>(T(i, j));
                         }
-                        while (origVolU > volU);
-                        U.set(x, y, U(x, y) - 1);
+                    }
+                    {
+#ifndef GENUSYS_NO_THREADING
+                        std::lock_guard<std::mutex> guard(mut);
+#endif
+                        typename std::unordered_map<std::vector<long long>, unsigned long long, KeyHash>::const_iterator it = volumes.find(key);
+                        if (it != volumes.end())
+                        {
+                            return it->second;
+                        }
+                    }
+
+                    // The bounds of getBounds: base^k * (T * digit) = T * invM^k * digit, and base^k = T * invM^k * T^-1
+                    const GeNuSys::LinAlg::SparseMatrix<RationalType> sparseT(T);
+                    const GeNuSys::LinAlg::SparseMatrix<RationalType> sparseInvT(GeNuSys::LinAlg::Algorithms::invert(T));
 
-                        newCandidates.push_back(Transformation<RationalType>(U, origVolU));
+                    std::vector<RationalType> low(N, 0);
+                    std::vector<RationalType> high(N, 0);
 
-                        GeNuSys::LinAlg::Matrix<RationalType> V = candidates[i].T;
-                        unsigned long long origVolV;
-                        unsigned long long volV = getVolume(invM, digitSet, V);
-                        do
+                    GeNuSys::LinAlg::Vector<RationalType> product(N);
+                    GeNuSys::LinAlg::Matrix<RationalType> TX(N, N), X(N, N);
+                    const GeNuSys::LinAlg::Matrix<RationalType>* power;
+                    const std::vector<GeNuSys::LinAlg::Vector<RationalType>>* products;
+                    unsigned int k = 1;
+                    getPower(k, power, products);
+                    do
+                    {
+                        std::vector<RationalType> min(N), max(N);
+                        for (unsigned int d = 0; d < products->size(); ++d)
                         {
-                            origVolV = volV;
-                            V.set(x, y, V(x, y) - 1);
-                            volV = getVolume(invM, digitSet, V);
+                            GeNuSys::LinAlg::Operations::mat_mul(sparseT, (*products)[d], product);
+                            for (unsigned int i = 0; i < N; ++i)
+                            {
+                                if (d == 0)
+                                {
+                                    min[i] = product[i];
+                                    max[i] = product[i];
+                                }
+                                else if (product[i] < min[i])
+                                {
+                                    min[i] = product[i];
+                                }
+                                if (product[i] > max[i])
+                                {
+                                    max[i] = product[i];
+                                }
+                            }
+                        }
+                        for (unsigned int i = 0; i < N; ++i)
+                        {
+                            low[i] += max[i];
+                            high[i] += min[i];
                         }
-                        while (origVolV > volV);
-                        V.set(x, y, V(x, y) + 1);
 
-                        newCandidates.push_back(Transformation<RationalType>(V, origVolV));
+                        getPower(++k, power, products);
+                        GeNuSys::LinAlg::Operations::mat_mul(sparseT, *power, TX);
+                        GeNuSys::LinAlg::Operations::mat_mul(TX, sparseInvT, X);
                     }
+                    while (ElementTraits<NormType>::template asType<double>(GeNuSys::LinAlg::PNorm<00>::norm(X)) > ElementTraits<double>::epsilon());
+
+                    typename ElementTraits<NormType>::RationalType coef =
+                        ElementTraits<NormType>::div(ElementTraits<NormType>::one(), ElementTraits<NormType>::one() - GeNuSys::LinAlg::PNorm<00>::norm(X));
+
+                    unsigned long long size = 1;
+                    for (unsigned int i = 0; i < N; ++i)
+                    {
+                        int lowerBound = ElementTraits<RationalType>::template asTypeUnsafe<int>(std::ceil(ElementTraits<RationalType>::template asTypeUnsafe<double>(-low[i] * coef)));
+                        int upperBound = ElementTraits<RationalType>::template asTypeUnsafe<int>(std::floor(ElementTraits<RationalType>::template asTypeUnsafe<double>(-high[i] * coef)));
+                        size *= upperBound - lowerBound + 1;
+                    }
+
+#ifndef GENUSYS_NO_THREADING
+                    std::lock_guard<std::mutex> guard(mut);
+#endif
+                    volumes[key] = size;
+
+                    return size;
+                }
+
+        };
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType
+            >
+        GeNuSys::LinAlg::Matrix<ElementType> Traits::findBasisTransformation(
+            const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& invM, const std::vector<VectorType<ElementType>>& digitSet,
+            const BasisSearchOptions& options)
+        {
+            typedef typename ElementTraits<ElementType>::RationalType RationalType;
+
+            if (options.candidates == 0 || options.mutations == 0)
+            {
+                throw std::invalid_argument{"BasisSearchOptions needs at least one candidate and one mutation per candidate"};
+            }
+
+            const unsigned int N = invM.getRows();
+
+            TransformationVolume<ElementType, VectorType> volume(invM, digitSet);
+
+            // The candidates U are upper unitriangular, the transformations U * start are unimodular
+            GeNuSys::LinAlg::Matrix<RationalType> start = GeNuSys::LinAlg::Matrix<RationalType>::identity(N, N);
+            unsigned long long origVol = volume(start);
+            if (options.reduceLattice)
+            {
+                GeNuSys::LinAlg::Matrix<RationalType> reduced = reduceBasis(invM, digitSet, options.deepInsertions);
+                unsigned long long reducedVol = volume(reduced);
+                if (reducedVol < origVol)
+                {
+                    start = reduced;
+                    origVol = reducedVol;
                 }
+            }
+
+            std::vector<Transformation<RationalType>> candidates(options.candidates, Transformation<RationalType>(GeNuSys::LinAlg::Matrix<RationalType>::identity(N, N), origVol));
+
+            // Moves U(x, y) by step while the volume decreases
+            auto climb = [&volume, &start](GeNuSys::LinAlg::Matrix<RationalType> U, unsigned int x, unsigned int y, int step)
+            {
+                unsigned long long origVol;
+                unsigned long long vol = volume(U * start);
+                do
+                {
+                    origVol = vol;
+                    U.set(x, y, U(x, y) + step);
+                    vol = volume(U * start);
+                }
+                while (origVol > vol);
+                U.set(x, y, U(x, y) - step);
+
+                return Transformation<RationalType>(U, origVol);
+            };
+
+            // The mutations are drawn before they are evaluated, so the result does not depend on the number of threads
+            std::mt19937 rng(options.seed);
+
+            // A single row has no off-diagonal entry to mutate
+            unsigned int noImpr = 0;
+            while (N > 1 && noImpr < options.noImprovementLimit)
+            {
+                std::vector<std::pair<unsigned int, unsigned int>> mutations(candidates.size() * options.mutations);
+                for (unsigned int m = 0; m < mutations.size(); ++m)
+                {
+                    unsigned int x, y;
+                    do
+                    {
+                        x = rng() % N;
+                        y = rng() % N;
+                    }
+                    while (x == y);
+
+                    mutations[m] = std::make_pair(std::min(x, y), std::max(x, y));
+                }
+
+                std::vector<Transformation<RationalType>> newCandidates(2 * mutations.size());
+                auto evaluate = [&](unsigned int m)
+                {
+                    const GeNuSys::LinAlg::Matrix<RationalType>& T = candidates[m / options.mutations].T;
+                    newCandidates[2 * m] = climb(T, mutations[m].first, mutations[m].second, 1);
+                    newCandidates[2 * m + 1] = climb(T, mutations[m].first, mutations[m].second, -1);
+                };
+
+#ifndef GENUSYS_NO_THREADING
+                uint32_t threadCount = std::min<uint32_t>(std::max<uint32_t>(thread_count::get(), 1), mutations.size());
+                std::atomic<unsigned int> next(0);
+                auto work = [&]()
+                {
+                    for (unsigned int m = next++; m < mutations.size(); m = next++)
+                    {
+                        evaluate(m);
+                    }
+                };
+                if (threadCount > 1)
+                {
+                    std::vector<std::thread> workers;
+                    for (uint32_t t = 0; t < threadCount; ++t)
+                    {
+                        workers.push_back(std::thread(work));
+                    }
+                    for (auto& w : workers)
+                    {
+                        w.join();
+                    }
+                }
+                else
+                {
+                    work();
+                }
+#else
+                for (unsigned int m = 0; m < mutations.size(); ++m)
+                {
+                    evaluate(m);
+                }
+#endif
 
                 std::sort(newCandidates.begin(), newCandidates.end());
 
@@ -256,7 +674,73 @@ namespace GeNuSys
             }
 
             //std::cout << "REDUCED : " << origVol << " -> " << candidates[0].vol << std::endl;
-            return GeNuSys::LinAlg::Traits::template convertUnsafe<RationalType, ElementType>(candidates[0].T);
+            return GeNuSys::LinAlg::Traits::template convertUnsafe<RationalType, ElementType>(candidates[0].T * start);
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType
+            >
+        GeNuSys::LinAlg::Matrix<ElementType> Traits::reduceBasis(
+            const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& invM, const std::vector<VectorType<ElementType>>& digitSet,
+            bool deepInsertions)
+        {
+            typedef typename ElementTraits<ElementType>::RationalType RationalType;
+
+            const unsigned int N = invM.getRows();
+
+            GeNuSys::LinAlg::Matrix<double> base = GeNuSys::LinAlg::Traits::template convertUnsafe<RationalType, double>(invM);
+            std::vector<GeNuSys::LinAlg::Vector<double>> digits(digitSet.size(), GeNuSys::LinAlg::Vector<double>(N));
+            for (unsigned int d = 0; d < digitSet.size(); ++d)
+            {
+                for (unsigned int i = 0; i < N; ++i)
+                {
+                    digits[d].set(i, ElementTraits<ElementType>::template asType<double>(digitSet[d][i]));
+                }
+            }
+
+            // The terms of the series of the periodic points, until they are negligible
+            GeNuSys::LinAlg::Matrix<double> gram(N, N);
+            GeNuSys::LinAlg::Matrix<double> X = base;
+            GeNuSys::LinAlg::Vector<double> term(N);
+            for (unsigned int k = 0; k < 1000 && GeNuSys::LinAlg::PNorm<00>::norm(X) > 1e-9; ++k)
+            {
+                for (unsigned int d = 0; d < digits.size(); ++d)
+                {
+                    GeNuSys::LinAlg::Operations::mat_mul(X, digits[d], term);
+                    for (unsigned int i = 0; i < N; ++i)
+                    {
+                        for (unsigned int j = 0; j < N; ++j)
+                        {
+                            gram.set(i, j, gram(i, j) + term[i] * term[j]);
+                        }
+                    }
+                }
+                X = base * X;
+            }
+
+            // The identity is kept if the reduction fails
+            GeNuSys::LinAlg::Matrix<ElementType> T = GeNuSys::LinAlg::Matrix<ElementType>::identity(N, N);
+            GeNuSys::LinAlg::Algorithms::reduceLLL(T, gram, deepInsertions);
+
+            return T;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class VectorType
+            >
+        GeNuSys::LinAlg::Matrix<ElementType> Traits::findBasisTransformation(
+            const GeNuSys::LinAlg::Matrix<typename ElementTraits<ElementType>::RationalType>& invM, const std::vector<VectorType<ElementType>>& digitSet,
+            const unsigned int candNum, const unsigned int mutateNum, const unsigned int noImprLimit)
+        {
+            BasisSearchOptions options;
+            options.candidates = candNum;
+            options.mutations = mutateNum;
+            options.noImprovementLimit = noImprLimit;
+            options.seed = rand();
+
+            return findBasisTransformation<ElementType, VectorType>(invM, digitSet, options);
         }
 
     }
@@ -51,6 +51,12 @@ namespace GeNuSys
 
                 OperatorNorm(const JordanForm<BaseType>& jordanForm);
 
+                // The norm of x is the maximum norm of S * x
+                const Matrix<ComplexRealType>& getS() const
+                {
+                    return S;
+                }
+
                 template<typename ElementType>
                 struct NormType
                 {
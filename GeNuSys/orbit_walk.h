@@ -0,0 +1,127 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GENUSYS_NUMSYS_ORBIT_WALK_H_
+#define GENUSYS_NUMSYS_ORBIT_WALK_H_
+
+#include <vector>
+#include <unordered_map>
+
+#include "bit_vector.h"
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        // Bookkeeping of a walk along an orbit in a search shared by concurrent walks. A point is claimed by
+        // the first walk reaching it, and settled once that walk is over, i.e. its orbit is known to lead to
+        // an invalid point or to an already reported cycle. A walk running into a claimed but unsettled point
+        // of another walk follows it instead of stopping, so a cycle shared by several walks is never lost.
+        class OrbitWalk
+        {
+
+            private:
+
+                std::unordered_map<unsigned long long, unsigned int> pathPos;
+
+                bool following;
+
+            public:
+
+                // Codes of the points visited, if the walk closed a loop the last one is repeated
+                std::vector<unsigned long long> path;
+
+                // Index of the start of the closed loop in path, or -1
+                int loopStart;
+
+                // The start point has to be claimed already
+                void begin(unsigned long long start)
+                {
+                    path.clear();
+                    pathPos.clear();
+                    path.push_back(start);
+                    following = false;
+                    loopStart = -1;
+                }
+
+                // Takes the next point of the orbit, returns false if the walk is over
+                bool visit(unsigned long long idx, bool valid, AtomicBitVector& claimed, const AtomicBitVector& settled)
+                {
+                    if (!valid)
+                    {
+                        return false;
+                    }
+
+                    if (!claimed.testAndSet(idx))
+                    {
+                        if (following)
+                        {
+                            pathPos[idx] = path.size();
+                        }
+                        path.push_back(idx);
+                        return true;
+                    }
+
+                    if (following)
+                    {
+                        auto pos = pathPos.find(idx);
+                        if (pos != pathPos.end())
+                        {
+                            loopStart = pos->second;
+                        }
+                    }
+                    else
+                    {
+                        for (int j = path.size() - 1; j >= 0; --j)
+                        {
+                            if (path[j] == idx)
+                            {
+                                loopStart = j;
+                                break;
+                            }
+                        }
+                    }
+
+                    if (loopStart >= 0 || settled[idx])
+                    {
+                        path.push_back(idx);
+                        return false;
+                    }
+
+                    if (!following)
+                    {
+                        following = true;
+                        for (unsigned int j = 0; j < path.size(); ++j)
+                        {
+                            pathPos[path[j]] = j;
+                        }
+                    }
+                    pathPos[idx] = path.size();
+                    path.push_back(idx);
+
+                    return true;
+                }
+
+        };
+
+    }
+}
+
+#endif // GENUSYS_NUMSYS_ORBIT_WALK_H_
@@ -23,6 +23,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "linalg_algorithms.h"
 #include "operator_norm.h"
+#include "divider.h"
 
 namespace GeNuSys
 {
@@ -45,6 +46,10 @@ namespace GeNuSys
 
                 ElementType absDetM;
 
+                Divider<ElementType> detDivider;
+
+                Divider<ElementType> absDetDivider;
+
                 GeNuSys::LinAlg::SmithNormalForm<ElementType> smithNormalForm;
 
                 GeNuSys::LinAlg::OperatorNorm<typename ElementTraits<ElementType>::RationalType> operatorNorm;
@@ -65,6 +70,11 @@ namespace GeNuSys
 
                 const ElementType& getAbsDet() const;
 
+                // Precomputed division by det and |det|, for loops dividing many values by them
+                const Divider<ElementType>& getDetDivider() const;
+
+                const Divider<ElementType>& getAbsDetDivider() const;
+
                 const GeNuSys::LinAlg::SmithNormalForm<ElementType>& getSmithNormalForm() const;
 
                 const GeNuSys::LinAlg::OperatorNorm<typename ElementTraits<ElementType>::RationalType>& getOperatorNorm() const;
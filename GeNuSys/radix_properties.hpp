@@ -31,6 +31,8 @@ namespace GeNuSys
             adjM(GeNuSys::LinAlg::Algorithms::getAdjoint(M)),
             detM(ElementTraits<typename ElementTraits<ElementType>::RationalType>::template asTypeUnsafe<ElementType>(GeNuSys::LinAlg::Algorithms::det(M))),
             absDetM(ElementTraits<ElementType>::abs(detM)),
+            detDivider(detM),
+            absDetDivider(absDetM),
             smithNormalForm(GeNuSys::LinAlg::Algorithms::getSmithNormalForm(M)),
             operatorNorm(GeNuSys::LinAlg::OperatorNorm<typename ElementTraits<ElementType>::RationalType>(GeNuSys::LinAlg::Algorithms::getJordanForm(invM)))
         {
@@ -72,6 +74,18 @@ namespace GeNuSys
             return absDetM;
         }
 
+        template<typename ElementType>
+        const Divider<ElementType>& RadixProperties<ElementType>::getDetDivider() const
+        {
+            return detDivider;
+        }
+
+        template<typename ElementType>
+        const Divider<ElementType>& RadixProperties<ElementType>::getAbsDetDivider() const
+        {
+            return absDetDivider;
+        }
+
         template<typename ElementType>
         const GeNuSys::LinAlg::SmithNormalForm<ElementType>& RadixProperties<ElementType>::getSmithNormalForm() const
         {
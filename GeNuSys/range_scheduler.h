@@ -0,0 +1,166 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GENUSYS_NUMSYS_RANGE_SCHEDULER_H_
+#define GENUSYS_NUMSYS_RANGE_SCHEDULER_H_
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace GeNuSys
+{
+    namespace NumSys
+    {
+
+        // Splits [0, size) into one contiguous range per worker. Workers consume their own range
+        // in chunks of grainSize elements, and an idle worker steals the back half of the largest
+        // remaining range, so every worker stays busy until the whole interval is processed.
+        class RangeScheduler
+        {
+
+            private:
+
+                struct Range
+                {
+                    std::mutex mut;
+
+                    unsigned long long begin;
+
+                    unsigned long long end;
+                };
+
+                std::vector<std::unique_ptr<Range>> ranges;
+
+                unsigned long long grainSize;
+
+                bool steal(unsigned int worker)
+                {
+                    while (true)
+                    {
+                        unsigned int victim = worker;
+                        unsigned long long most = 0;
+                        for (unsigned int i = 0; i < ranges.size(); ++i)
+                        {
+                            if (i == worker)
+                            {
+                                continue;
+                            }
+                            std::lock_guard<std::mutex> guard(ranges[i]->mut);
+                            if (ranges[i]->end - ranges[i]->begin > most)
+                            {
+                                most = ranges[i]->end - ranges[i]->begin;
+                                victim = i;
+                            }
+                        }
+                        if (most == 0)
+                        {
+                            return false;
+                        }
+
+                        unsigned long long begin, end;
+                        {
+                            std::lock_guard<std::mutex> guard(ranges[victim]->mut);
+                            unsigned long long remaining = ranges[victim]->end - ranges[victim]->begin;
+                            if (remaining == 0)
+                            {
+                                continue;
+                            }
+                            begin = (remaining <= grainSize) ? ranges[victim]->begin : ranges[victim]->begin + remaining / 2;
+                            end = ranges[victim]->end;
+                            ranges[victim]->end = begin;
+                        }
+
+                        std::lock_guard<std::mutex> guard(ranges[worker]->mut);
+                        ranges[worker]->begin = begin;
+                        ranges[worker]->end = end;
+
+                        return true;
+                    }
+                }
+
+            public:
+
+                RangeScheduler(unsigned long long size, unsigned int workerCount, unsigned long long grainSize): grainSize(grainSize > 0 ? grainSize : 1)
+                {
+                    const unsigned long long rangeSize = size / workerCount;
+                    for (unsigned int i = 0; i < workerCount; ++i)
+                    {
+                        ranges.push_back(std::unique_ptr<Range>(new Range()));
+                        ranges[i]->begin = i * rangeSize;
+                        ranges[i]->end = (i == workerCount - 1) ? size : (i + 1) * rangeSize;
+                    }
+                }
+
+                // Continues with the given ranges, e.g. the ones left over by a previous scheduler. Surplus ranges
+                // are stolen by the workers, surplus workers start by stealing.
+                RangeScheduler(const std::vector<std::pair<unsigned long long, unsigned long long>>& initialRanges, unsigned int workerCount,
+                               unsigned long long grainSize): grainSize(grainSize > 0 ? grainSize : 1)
+                {
+                    for (unsigned int i = 0; i < workerCount || i < initialRanges.size(); ++i)
+                    {
+                        ranges.push_back(std::unique_ptr<Range>(new Range()));
+                        ranges[i]->begin = (i < initialRanges.size()) ? initialRanges[i].first : 0;
+                        ranges[i]->end = (i < initialRanges.size()) ? initialRanges[i].second : 0;
+                    }
+                }
+
+                // Returns the ranges not handed out yet
+                std::vector<std::pair<unsigned long long, unsigned long long>> getRanges()
+                {
+                    std::vector<std::pair<unsigned long long, unsigned long long>> result;
+                    for (unsigned int i = 0; i < ranges.size(); ++i)
+                    {
+                        std::lock_guard<std::mutex> guard(ranges[i]->mut);
+                        if (ranges[i]->begin < ranges[i]->end)
+                        {
+                            result.push_back(std::make_pair(ranges[i]->begin, ranges[i]->end));
+                        }
+                    }
+
+                    return result;
+                }
+
+                // Returns the next chunk [begin, end) of the given worker, or false if no work is left.
+                bool next(unsigned int worker, unsigned long long& begin, unsigned long long& end)
+                {
+                    do
+                    {
+                        std::lock_guard<std::mutex> guard(ranges[worker]->mut);
+                        if (ranges[worker]->begin < ranges[worker]->end)
+                        {
+                            begin = ranges[worker]->begin;
+                            end = (ranges[worker]->end - begin > grainSize) ? begin + grainSize : ranges[worker]->end;
+                            ranges[worker]->begin = end;
+
+                            return true;
+                        }
+                    }
+                    while (steal(worker));
+
+                    return false;
+                }
+
+        };
+
+    }
+}
+
+#endif // GENUSYS_NUMSYS_RANGE_SCHEDULER_H_
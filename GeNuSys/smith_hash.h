@@ -58,6 +58,14 @@ namespace GeNuSys
 
                 ElementType operator()(const GeNuSys::LinAlg::Vector<ElementType>& z, GeNuSys::LinAlg::Vector<ElementType>& Uz) const;
 
+                unsigned int getSize() const;
+
+                const MatrixType<ElementType>& getU() const;
+
+                const GeNuSys::LinAlg::Vector<ElementType>& getG() const;
+
+                const GeNuSys::LinAlg::Vector<ElementType>& getProdG() const;
+
         };
 
     }
@@ -92,5 +92,41 @@ namespace GeNuSys
             return sum;
         }
 
+        template <
+            typename ElementType,
+            template<typename> class MatrixType
+            >
+        unsigned int SmithHash<ElementType, MatrixType>::getSize() const
+        {
+            return size;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class MatrixType
+            >
+        const MatrixType<ElementType>& SmithHash<ElementType, MatrixType>::getU() const
+        {
+            return U;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class MatrixType
+            >
+        const GeNuSys::LinAlg::Vector<ElementType>& SmithHash<ElementType, MatrixType>::getG() const
+        {
+            return G;
+        }
+
+        template <
+            typename ElementType,
+            template<typename> class MatrixType
+            >
+        const GeNuSys::LinAlg::Vector<ElementType>& SmithHash<ElementType, MatrixType>::getProdG() const
+        {
+            return prodG;
+        }
+
     }
 }
@@ -0,0 +1,68 @@
+/*
+GeNuSys - computations with generalized number systems
+Copyright (C) 2015-2017  Bence Németh
+Copyright (C) 2017  Tamás Krutki
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef GENUSYS_THREADING_H_
+#define GENUSYS_THREADING_H_
+
+#include <cstdint>
+
+namespace GeNuSys
+{
+#ifndef GENUSYS_NO_THREADING
+    struct thread_count
+    {
+        public:
+            static uint32_t get()
+            {
+                return tc();
+            }
+            static void set(uint32_t t_c)
+            {
+                tc() = t_c;
+            }
+        private:
+            static uint32_t& tc()
+            {
+                static uint32_t _tc = 1;
+                return _tc;
+            }
+    };
+
+    struct grain_size
+    {
+        public:
+            static uint64_t get()
+            {
+                return gs();
+            }
+            static void set(uint64_t g_s)
+            {
+                gs() = g_s;
+            }
+        private:
+            static uint64_t& gs()
+            {
+                static uint64_t _gs = 4096;
+                return _gs;
+            }
+    };
+#endif
+}
+
+#endif // GENUSYS_THREADING_H_
@@ -29,6 +29,9 @@ namespace GeNuSys
     namespace NumSys
     {
 
+        // Encodes the points of a box by consecutive integers. Cycle searches work on any domain coder with the interface of
+        // this class: the codes are 0..getSize()-1 and follow the order of the codes of the bounding box (getBox), toBox and
+        // fromBox convert between the two.
         class VectorCoder
         {
 
@@ -40,6 +43,9 @@ namespace GeNuSys
 
                 std::vector<unsigned int> varBase;
 
+                // The code is the sum of (z[j] - lowerBound[j]) * stride[j]
+                std::vector<unsigned long long> stride;
+
                 unsigned long long size;
 
             public:
@@ -47,24 +53,56 @@ namespace GeNuSys
                 VectorCoder(const std::vector<int>& lowerBound, const std::vector<int>& upperBound): lowerBound(lowerBound), upperBound(upperBound)
                 {
                     varBase = std::vector<unsigned int>(lowerBound.size());
+                    stride = std::vector<unsigned long long>(lowerBound.size());
                     size = 1;
                     for (unsigned int i = 0; i < lowerBound.size(); ++i)
                     {
                         varBase[i] = upperBound[i] - lowerBound[i] + 1;
+                        stride[i] = size;
                         size *= varBase[i];
                     }
                 }
 
-                unsigned long long getSize()
+                unsigned long long getSize() const
                 {
                     return size;
                 }
 
+                const VectorCoder& getBox() const
+                {
+                    return *this;
+                }
+
+                unsigned long long toBox(unsigned long long code) const
+                {
+                    return code;
+                }
+
+                // valid is cleared if the point of the box code is not in the domain
+                unsigned long long fromBox(unsigned long long boxCode, bool&) const
+                {
+                    return boxCode;
+                }
+
+                const std::vector<int>& getLowerBound() const
+                {
+                    return lowerBound;
+                }
+
+                const std::vector<int>& getUpperBound() const
+                {
+                    return upperBound;
+                }
+
+                template<typename ElementType>
+                unsigned long long encode(const GeNuSys::LinAlg::Vector<ElementType>& z, bool& valid) const;
+
                 template<typename ElementType>
-                unsigned long long encode(const GeNuSys::LinAlg::Vector<ElementType>& z, bool& valid);
+                void decode(unsigned long long code, GeNuSys::LinAlg::Vector<ElementType>& z) const;
 
+                // Sets z to the point of the next code, i.e. decode(code + 1, z) if z is the point of code
                 template<typename ElementType>
-                void decode(unsigned long long code, GeNuSys::LinAlg::Vector<ElementType>& z);
+                void increment(GeNuSys::LinAlg::Vector<ElementType>& z) const;
 
         };
 
@@ -17,6 +17,8 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <type_traits>
+
 #include "element_traits.h"
 
 namespace GeNuSys
@@ -25,32 +27,31 @@ namespace GeNuSys
     {
 
         template<typename ElementType>
-        unsigned long long VectorCoder::encode(const GeNuSys::LinAlg::Vector<ElementType>& z, bool& valid)
+        unsigned long long VectorCoder::encode(const GeNuSys::LinAlg::Vector<ElementType>& z, bool& valid) const
         {
-            valid = true;
+            // The coordinates are independent, and a coordinate below its lower bound wraps around to a huge
+            // offset, so a single unsigned comparison checks both bounds
+            bool inside = true;
             unsigned long long code = 0;
-            for (int j = z.getLength() - 1; j > 0; --j)
+            for (unsigned int j = 0; j < z.getLength(); ++j)
             {
-                if ((lowerBound[j] > ElementTraits<ElementType>::template asTypeUnsafe<long long>(z[j]))
-                        || (ElementTraits<ElementType>::template asTypeUnsafe<long long>(z[j]) > upperBound[j]))
+                // A wider element type might not fit into long long, it is compared to the bounds before the conversion
+                if (!std::is_same<ElementType, long long>::value && (z[j] < lowerBound[j] || z[j] > upperBound[j]))
                 {
                     valid = false;
+                    return 0;
                 }
-                code += ElementTraits<ElementType>::template asTypeUnsafe<long long>(z[j]) - lowerBound[j];
-                code *= varBase[j - 1];
-            }
-            if ((lowerBound[0] > ElementTraits<ElementType>::template asTypeUnsafe<long long>(z[0]))
-                    || (ElementTraits<ElementType>::template asTypeUnsafe<long long>(z[0]) > upperBound[0]))
-            {
-                valid = false;
+                unsigned long long offset = (unsigned long long) (ElementTraits<ElementType>::template asTypeUnsafe<long long>(z[j]) - lowerBound[j]);
+                inside &= (offset < varBase[j]);
+                code += offset * stride[j];
             }
-            code += ElementTraits<ElementType>::template asTypeUnsafe<long long>(z[0]) - lowerBound[0];
+            valid = inside;
 
             return code;
         }
 
         template<typename ElementType>
-        void VectorCoder::decode(unsigned long long code, GeNuSys::LinAlg::Vector<ElementType>& z)
+        void VectorCoder::decode(unsigned long long code, GeNuSys::LinAlg::Vector<ElementType>& z) const
         {
             for (unsigned int j = 0; j < z.getLength(); ++j)
             {
@@ -59,5 +60,19 @@ namespace GeNuSys
             }
         }
 
+        template<typename ElementType>
+        void VectorCoder::increment(GeNuSys::LinAlg::Vector<ElementType>& z) const
+        {
+            for (unsigned int j = 0; j < z.getLength(); ++j)
+            {
+                if (ElementTraits<ElementType>::template asTypeUnsafe<long long>(z[j]) < upperBound[j])
+                {
+                    z.set(j, z[j] + ElementTraits<ElementType>::one());
+                    return;
+                }
+                z.set(j, ElementTraits<long long>::template asTypeUnsafe<ElementType>(lowerBound[j]));
+            }
+        }
+
     }
 }
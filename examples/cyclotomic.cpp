@@ -110,7 +110,7 @@ int main()
             }
             std::cout << "Creating number system object..." << std::endl;
             std::cout << "Volume:" << GeNuSys::NumSys::Traits::getVolume(props.getInverse(), sds) << std::endl;
-            GeNuSys::LinAlg::Matrix<long long> T = GeNuSys::NumSys::Traits::findBasisTransformation(props.getInverse(), sds, 15, 5, 2);
+            GeNuSys::LinAlg::Matrix<long long> T = GeNuSys::NumSys::Traits::findBasisTransformation(props.getInverse(), sds, GeNuSys::NumSys::BasisSearchOptions());
             auto imprM = T * mat.second * GeNuSys::LinAlg::Traits::template convertUnsafe<typename GeNuSys::ElementTraits<long long int>::RationalType, long long>(GeNuSys::LinAlg::Algorithms::invert(T));
             std::vector<GeNuSys::LinAlg::SparseVector<long long>> imprDigits;
             for (unsigned int i = 0; i < sds.size(); ++i)
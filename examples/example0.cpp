@@ -85,7 +85,7 @@ int main()
     }
 
     //Optimize the base matrix to reduce volume
-    GeNuSys::LinAlg::Matrix<long long> T = GeNuSys::NumSys::Traits::findBasisTransformation(props.getInverse(), symmetric, 15, 5, 2);
+    GeNuSys::LinAlg::Matrix<long long> T = GeNuSys::NumSys::Traits::findBasisTransformation(props.getInverse(), symmetric, GeNuSys::NumSys::BasisSearchOptions());
 
     //Compute the improved matrix and digit set (apply the previously computed T transformation matrix)
     auto imprM = T * matrix * GeNuSys::LinAlg::Traits::template convertUnsafe<typename GeNuSys::ElementTraits<long long int>::RationalType, long long>(GeNuSys::LinAlg::Algorithms::invert(T));
@@ -276,7 +276,7 @@ void exampleSimultaneous(const int i, const int j, bool impr)
 
     if (impr)
     {
-        GeNuSys::LinAlg::Matrix<int> T = GeNuSys::NumSys::Traits::findBasisTransformation(props.getInverse(), digits, 15, 5, 2);
+        GeNuSys::LinAlg::Matrix<int> T = GeNuSys::NumSys::Traits::findBasisTransformation(props.getInverse(), digits, GeNuSys::NumSys::BasisSearchOptions());
 
         imprM = T * M * GeNuSys::LinAlg::Traits::template convertUnsafe<double, int>(GeNuSys::LinAlg::Algorithms::invert(T));
         for (unsigned int i = 0; i < digits.size(); ++i)
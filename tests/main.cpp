@@ -60,6 +60,9 @@ int runTests()
     testRunner.addTestSuite(new VectorNormTest());
     testRunner.addTestSuite(new MatrixTest());
     testRunner.addTestSuite(new MatrixNormTest());
+    testRunner.addTestSuite(new DividerTest());
+    testRunner.addTestSuite(new HybridIntegerTest());
+    testRunner.addTestSuite(new NumberSystemTest());
     testRunner.run();
 
     return testRunner.returnCode();
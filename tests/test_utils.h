@@ -20,6 +20,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef GENUSYS_TESTS_TEST_UTILS_H_
 #define GENUSYS_TESTS_TEST_UTILS_H_
 
+#include <vector>
+#include <iostream>
+
 #include <GeNuSys/element_traits.h>
 
 #include <GeNuSys/vector.h>
@@ -61,6 +64,46 @@ namespace GeNuSys
 
         };
 
+        // The cycles of a search as exact integers, so that assertEqual can compare (and print) the cycles of
+        // number systems of different element types
+        class CycleSet
+        {
+
+            private:
+
+                std::vector<std::vector<std::vector<mpz_class>>> cycles;
+
+            public:
+
+                template<typename ElementType>
+                CycleSet(const std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>>& cycles);
+
+                bool operator ==(const CycleSet& cycleSet) const;
+
+                bool operator !=(const CycleSet& cycleSet) const;
+
+                friend std::ostream& operator <<(std::ostream& os, const CycleSet& cycleSet)
+                {
+                    os << "{";
+                    for (unsigned int i = 0; i < cycleSet.cycles.size(); ++i)
+                    {
+                        os << (i == 0 ? " (" : ", (");
+                        for (unsigned int j = 0; j < cycleSet.cycles[i].size(); ++j)
+                        {
+                            os << (j == 0 ? "[" : " -> [");
+                            for (unsigned int k = 0; k < cycleSet.cycles[i][j].size(); ++k)
+                            {
+                                os << (k == 0 ? "" : " ") << cycleSet.cycles[i][j][k].get_str();
+                            }
+                            os << "]";
+                        }
+                        os << ")";
+                    }
+                    return os << " }";
+                }
+
+        };
+
     }
 }
 
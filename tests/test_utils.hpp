@@ -162,5 +162,32 @@ namespace GeNuSys
             return equals;
         }
 
+        template<typename ElementType>
+        CycleSet::CycleSet(const std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>>& cycles): cycles(cycles.size())
+        {
+            for (unsigned int i = 0; i < cycles.size(); ++i)
+            {
+                for (unsigned int j = 0; j < cycles[i].size(); ++j)
+                {
+                    std::vector<mpz_class> point(cycles[i][j].getLength());
+                    for (unsigned int k = 0; k < point.size(); ++k)
+                    {
+                        point[k] = ElementTraits<ElementType>::template asType<mpz_class>(cycles[i][j][k]);
+                    }
+                    this->cycles[i].push_back(point);
+                }
+            }
+        }
+
+        inline bool CycleSet::operator ==(const CycleSet& cycleSet) const
+        {
+            return cycles == cycleSet.cycles;
+        }
+
+        inline bool CycleSet::operator !=(const CycleSet& cycleSet) const
+        {
+            return cycles != cycleSet.cycles;
+        }
+
     }
 }
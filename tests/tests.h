@@ -31,6 +31,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <GeNuSys/frobenius_norm.h>
 #include <GeNuSys/operator_norm.h>
 
+#include <GeNuSys/number_system.h>
+#include <GeNuSys/radix_properties.h>
+#include <GeNuSys/digit_set.h>
+
 class VectorTest : public GeNuSys::Tests::TestSuite
 {
 
@@ -766,6 +770,20 @@ class MatrixTest : public GeNuSys::Tests::TestSuite
             }
 
             assertTrue(assignSparseEquals, "Matrix matches original after assign sparse");
+
+            GeNuSys::LinAlg::Matrix<int> denseFactor(4, 4);
+            for (unsigned int i = 0; i < 4; ++i)
+            {
+                for (unsigned int j = 0; j < 4; ++j)
+                {
+                    denseFactor.set(i, j, (int) (i * 4 + j) - 7);
+                }
+            }
+
+            GeNuSys::LinAlg::Matrix<int> product(4, 4);
+            GeNuSys::LinAlg::Operations::mat_mul(denseFactor, sparseMatrix, product);
+            GeNuSys::LinAlg::Operations::mat_mul(denseFactor, sparseMatrix, product);
+            assertTrue(product == denseFactor * GeNuSys::LinAlg::Matrix<int>(sparseMatrix), "Product of dense and sparse matrix overwrites the result");
         }
 
 };
@@ -853,6 +871,829 @@ class MatrixNormTest : public GeNuSys::Tests::TestSuite
 
 };
 
+class DividerTest : public GeNuSys::Tests::TestSuite
+{
+
+    public:
+
+        DividerTest(): TestSuite("Divider") {}
+
+        void run()
+        {
+            std::vector<long long> divisors;
+            for (long long d = -64; d <= 64; ++d)
+            {
+                if (d != 0)
+                {
+                    divisors.push_back(d);
+                }
+            }
+            divisors.push_back(641);
+            divisors.push_back(-1000000007);
+            divisors.push_back(3LL << 40);
+            divisors.push_back(-(7LL << 50));
+
+            std::vector<long long> values;
+            for (long long a = -1000; a <= 1000; ++a)
+            {
+                values.push_back(a);
+            }
+            values.push_back(1234567890123LL);
+            values.push_back(-987654321098765LL);
+            values.push_back(1LL << 60);
+            values.push_back(-(1LL << 60) + 1);
+
+            int quotientErrors = 0;
+            int exactErrors = 0;
+            int modErrors = 0;
+            int modsErrors = 0;
+            for (unsigned int i = 0; i < divisors.size(); ++i)
+            {
+                long long d = divisors[i];
+                GeNuSys::Divider<long long> divider(d);
+                for (unsigned int j = 0; j < values.size(); ++j)
+                {
+                    long long a = values[j];
+                    quotientErrors += (divider.quotient(a) != GeNuSys::ElementTraits<long long>::idiv(a, d));
+                    modErrors += (divider.mod(a) != GeNuSys::ElementTraits<long long>::mod(a, d));
+                    modsErrors += (divider.mods(a) != GeNuSys::ElementTraits<long long>::mods(a, d));
+                    long long q = a / d;
+                    exactErrors += (divider.exactQuotient(q * d) != q);
+                }
+            }
+
+            assertEqual(0, quotientErrors, "quotient of long long divider");
+            assertEqual(0, exactErrors, "exact quotient of long long divider");
+            assertEqual(0, modErrors, "mod of long long divider");
+            assertEqual(0, modsErrors, "mods of long long divider");
+
+            GeNuSys::LinAlg::Vector<long long> v(3);
+            v.set(0, -21);
+            v.set(1, 14);
+            v.set(2, 0);
+            GeNuSys::LinAlg::Operations::vct_exdiv(v, GeNuSys::Divider<long long>(-7));
+
+            GeNuSys::LinAlg::Vector<long long> expected(3);
+            expected.set(0, 3);
+            expected.set(1, -2);
+            expected.set(2, 0);
+            assertEqual(expected, v, "exact division of vector by divider");
+        }
+
+};
+
+class HybridIntegerTest : public GeNuSys::Tests::TestSuite
+{
+
+    public:
+
+        HybridIntegerTest(): TestSuite("HybridInteger") {}
+
+        void run()
+        {
+            const long long maxValue = std::numeric_limits<long long>::max();
+            const long long minValue = std::numeric_limits<long long>::min();
+            std::vector<GeNuSys::HybridInteger> values;
+            long long smallValues[] = {0, 1, -1, 2, -3, 7, -64, 1000000007, maxValue, maxValue - 1, minValue, minValue + 1, 3037000499LL, -3037000500LL};
+            for (unsigned int i = 0; i < sizeof(smallValues) / sizeof(smallValues[0]); ++i)
+            {
+                values.push_back(smallValues[i]);
+            }
+            values.push_back(GeNuSys::HybridInteger(mpz_class("123456789012345678901234567890")));
+            values.push_back(GeNuSys::HybridInteger(mpz_class("-9223372036854775809")));
+            values.push_back(GeNuSys::HybridInteger(mpz_class("9223372036854775808")));
+
+            int arithmeticErrors = 0;
+            int traitsErrors = 0;
+            for (unsigned int i = 0; i < values.size(); ++i)
+            {
+                const GeNuSys::HybridInteger& a = values[i];
+                mpz_class exactA = a.toMpz();
+                arithmeticErrors += ((-a).toMpz() != -exactA);
+                GeNuSys::HybridInteger twice = a;
+                twice += twice;
+                GeNuSys::HybridInteger square = a;
+                square *= square;
+                arithmeticErrors += (twice.toMpz() != 2 * exactA) + (square.toMpz() != exactA * exactA);
+                for (unsigned int j = 0; j < values.size(); ++j)
+                {
+                    const GeNuSys::HybridInteger& b = values[j];
+                    mpz_class exactB = b.toMpz();
+                    arithmeticErrors += ((a + b).toMpz() != exactA + exactB);
+                    arithmeticErrors += ((a - b).toMpz() != exactA - exactB);
+                    arithmeticErrors += ((a * b).toMpz() != exactA * exactB);
+                    arithmeticErrors += ((a < b) != (exactA < exactB)) + ((a == b) != (exactA == exactB)) + ((a > b) != (exactA > exactB));
+                    if (exactB != 0)
+                    {
+                        arithmeticErrors += ((a / b).toMpz() != exactA / exactB);
+                        arithmeticErrors += ((a % b).toMpz() != exactA % exactB);
+                        traitsErrors += (GeNuSys::ElementTraits<GeNuSys::HybridInteger>::idiv(a, b).toMpz() != GeNuSys::ElementTraits<mpz_class>::idiv(exactA, exactB));
+                        traitsErrors += (GeNuSys::ElementTraits<GeNuSys::HybridInteger>::mod(a, b).toMpz() != GeNuSys::ElementTraits<mpz_class>::mod(exactA, exactB));
+                        traitsErrors += (GeNuSys::ElementTraits<GeNuSys::HybridInteger>::mods(a, b).toMpz() != GeNuSys::ElementTraits<mpz_class>::mods(exactA, exactB));
+                        traitsErrors += (GeNuSys::ElementTraits<GeNuSys::HybridInteger>::divisible(a, b) != GeNuSys::ElementTraits<mpz_class>::divisible(exactA, exactB));
+                    }
+                }
+            }
+            assertEqual(0, arithmeticErrors, "Arithmetic matches mpz_class across the overflow boundary");
+            assertEqual(0, traitsErrors, "idiv, mod, mods and divisible match mpz_class");
+            assertTrue((GeNuSys::HybridInteger(maxValue) + 1 - 1).isSmall(), "Values which fit into long long are stored inline");
+
+            GeNuSys::LinAlg::Matrix<long long> base(3, 3, std::vector<long long> {0, 0, -7, 1, 0, 1, 0, 1, 6});
+            GeNuSys::LinAlg::SmithNormalForm<mpz_class> exactSmith = GeNuSys::LinAlg::Algorithms::getSmithNormalForm(GeNuSys::LinAlg::Matrix<mpz_class>(base));
+            GeNuSys::LinAlg::SmithNormalForm<GeNuSys::HybridInteger> smith = GeNuSys::LinAlg::Algorithms::getSmithNormalForm(GeNuSys::LinAlg::Matrix<GeNuSys::HybridInteger>(base));
+            assertTrue(GeNuSys::LinAlg::Matrix<mpz_class>(smith.S) == exactSmith.S && GeNuSys::LinAlg::Matrix<mpz_class>(smith.U) == exactSmith.U,
+                       "Smith normal form matches mpz_class");
+
+            // The first pivot is zero, so the fraction-free eliminations have to swap rows
+            GeNuSys::LinAlg::Matrix<long long> swapped(4, 4, std::vector<long long> {0, 3, -1, 2, 5, 1, 0, -4, 2, -2, 7, 1, -3, 6, 1, 0});
+            GeNuSys::LinAlg::Matrix<mpz_class> exactSwapped = swapped;
+            mpq_class exactDet = GeNuSys::LinAlg::Algorithms::det(exactSwapped, std::false_type());
+            GeNuSys::LinAlg::Matrix<mpz_class> exactAdj = GeNuSys::LinAlg::Algorithms::getAdjoint(exactSwapped, std::false_type());
+            assertTrue(GeNuSys::LinAlg::Algorithms::det(exactSwapped) == exactDet && GeNuSys::LinAlg::Algorithms::det(swapped) == exactDet.get_d(),
+                       "Fraction-free determinant matches the rational one");
+            assertTrue(GeNuSys::LinAlg::Algorithms::getAdjoint(exactSwapped) == exactAdj && GeNuSys::LinAlg::Matrix<mpz_class>(GeNuSys::LinAlg::Algorithms::getAdjoint(swapped)) == exactAdj,
+                       "Fraction-free adjoint matches the rational one");
+
+            GeNuSys::LinAlg::Matrix<long long> deficient(3, 3, std::vector<long long> {0, 2, 4, 0, 1, 2, 0, 3, 7});
+            assertTrue(GeNuSys::LinAlg::Algorithms::getRank(deficient) == 2 && GeNuSys::LinAlg::Algorithms::getRank(GeNuSys::LinAlg::Matrix<mpz_class>(deficient)) == 2,
+                       "Fraction-free rank skips columns without a pivot");
+
+            // The minors exceed long long, the fraction-free eliminations stay exact in HybridInteger
+            const unsigned int N = 10;
+            GeNuSys::LinAlg::Matrix<long long> dense(N, N);
+            long long seed = 12345;
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    seed = (seed * 48271) % 2147483647;
+                    dense.set(i, j, seed % 1000003 - 500001);
+                }
+            }
+            GeNuSys::LinAlg::Matrix<GeNuSys::HybridInteger> hybridDense = dense;
+            GeNuSys::HybridInteger denseDet = GeNuSys::LinAlg::Algorithms::detBareiss(hybridDense);
+            GeNuSys::LinAlg::Matrix<GeNuSys::HybridInteger> denseAdj = GeNuSys::LinAlg::Algorithms::getAdjoint(hybridDense);
+            assertTrue(!denseDet.isSmall() && denseAdj * hybridDense == GeNuSys::LinAlg::Matrix<GeNuSys::HybridInteger>::identity(N, N) * denseDet,
+                       "Fraction-free adjoint of a matrix with large minors");
+        }
+
+};
+
+class NumberSystemTest : public GeNuSys::Tests::TestSuite
+{
+
+    public:
+
+        NumberSystemTest(): TestSuite("NumberSystem") {}
+
+        typedef GeNuSys::NumSys::NumberSystem<long long, GeNuSys::LinAlg::SparseVector, GeNuSys::LinAlg::Matrix, GeNuSys::LinAlg::OperatorNorm<double>> NumSysType;
+
+        typedef std::vector<std::vector<GeNuSys::LinAlg::Vector<long long>>> CyclesType;
+
+        typedef GeNuSys::ElementTraits<long long>::RationalType RationalType;
+
+        // The j-symmetric number system of a base, the search space of its cycles is the box of getBounds
+        static NumSysType createNumSys(const GeNuSys::LinAlg::Matrix<long long>& base)
+        {
+            GeNuSys::NumSys::RadixProperties<long long> props(base);
+
+            return NumSysType(props, GeNuSys::NumSys::DigitSet::getJSymmetric(props, 0), props.getOperatorNorm());
+        }
+
+        static GeNuSys::LinAlg::Matrix<long long> getBase()
+        {
+            return GeNuSys::LinAlg::Matrix<long long>(2, 2, std::vector<long long> {0, -7, 1, -5});
+        }
+
+        // The cycles of getBase, sorted and starting with their smallest element
+        static CyclesType getExpectedCycles()
+        {
+            CyclesType expected(2);
+            expected[0].push_back(GeNuSys::LinAlg::Vector<long long>(2));
+            expected[0][0].set(0, -4);
+            expected[0][0].set(1, -1);
+            expected[0].push_back(GeNuSys::LinAlg::Vector<long long>(2));
+            expected[0][1].set(0, 4);
+            expected[0][1].set(1, 1);
+            expected[0].push_back(expected[0][0]);
+            expected[1].push_back(GeNuSys::LinAlg::Vector<long long>(2));
+            expected[1].push_back(GeNuSys::LinAlg::Vector<long long>(2));
+
+            return expected;
+        }
+
+        // Covers 3 of the 5 residue classes of getShortBase, the hashes of the digits are 0, 1 and 2, the hash of (2, 0) is 3
+        static std::vector<GeNuSys::LinAlg::Vector<long long>> getShortDigits()
+        {
+            std::vector<GeNuSys::LinAlg::Vector<long long>> digits(3, GeNuSys::LinAlg::Vector<long long>(2));
+            digits[1].set(0, -1);
+            digits[2].set(0, -2);
+
+            return digits;
+        }
+
+        static GeNuSys::LinAlg::Matrix<long long> getShortBase()
+        {
+            return GeNuSys::LinAlg::Matrix<long long>(2, 2, std::vector<long long> {0, -5, 1, -2});
+        }
+
+        // A domain coder without any point in its box
+        class EmptyCoder: public GeNuSys::NumSys::RowCoder
+        {
+
+            private:
+
+                struct NoRows
+                {
+                    bool operator()(unsigned long long, unsigned long long&, unsigned long long&) const
+                    {
+                        return false;
+                    }
+                };
+
+            public:
+
+                EmptyCoder(const std::vector<int>& lowerBound, const std::vector<int>& upperBound)
+                {
+                    NoRows range;
+                    init(lowerBound, upperBound, range);
+                }
+
+        };
+
+        // A base whose box has points far from the attractor, used by the tests of the search space reductions
+        static GeNuSys::LinAlg::Matrix<long long> getSieveBase()
+        {
+            return GeNuSys::LinAlg::Matrix<long long>(3, 3, std::vector<long long> {0, 0, -7, 1, 0, 1, 0, 1, 6});
+        }
+
+        void testCycles()
+        {
+            NumSysType numSys = createNumSys(getBase());
+            assertEqual(GeNuSys::Tests::CycleSet(getExpectedCycles()), GeNuSys::Tests::CycleSet(numSys.getCycles()), "Cycles are sorted and start with their smallest element");
+        }
+
+        void testVisitor()
+        {
+            NumSysType numSys = createNumSys(getBase());
+            unsigned int visited = 0;
+            bool completed = numSys.visitCycles([&visited](const std::vector<GeNuSys::LinAlg::Vector<long long>>&)
+            {
+                ++visited;
+                return true;
+            });
+            assertTrue(completed, "Visitor completes the search");
+            assertEqual(2u, visited, "Visitor sees every cycle");
+
+            visited = 0;
+            completed = numSys.visitCycles([&visited](const std::vector<GeNuSys::LinAlg::Vector<long long>>&)
+            {
+                ++visited;
+                return false;
+            });
+            assertFalse(completed, "Visitor stops the search");
+            assertEqual(1u, visited, "Visitor sees no cycle after stopping");
+
+#ifndef GENUSYS_NO_THREADING
+            GeNuSys::thread_count::set(3);
+            GeNuSys::grain_size::set(1);
+            visited = 0;
+            completed = numSys.visitCycles([&visited](const std::vector<GeNuSys::LinAlg::Vector<long long>>&)
+            {
+                ++visited;
+                return false;
+            });
+            assertFalse(completed, "Visitor stops the threaded search");
+            assertEqual(1u, visited, "Visitor sees no cycle after stopping the threaded search");
+            GeNuSys::thread_count::set(1);
+            GeNuSys::grain_size::set(4096);
+#endif
+        }
+
+        void testThreading()
+        {
+#ifndef GENUSYS_NO_THREADING
+            NumSysType numSys = createNumSys(getBase());
+            GeNuSys::thread_count::set(3);
+            GeNuSys::grain_size::set(1);
+            assertEqual(GeNuSys::Tests::CycleSet(getExpectedCycles()), GeNuSys::Tests::CycleSet(numSys.getCycles()), "Threaded cycle search matches serial result");
+            GeNuSys::thread_count::set(1);
+            GeNuSys::grain_size::set(4096);
+#endif
+        }
+
+        void testVisitedSetFile()
+        {
+#ifdef __unix__
+            NumSysType numSys = createNumSys(getBase());
+            GeNuSys::NumSys::CycleSearchOptions options;
+            options.visitedSetFile = "genusys_test_visited.bin";
+            assertEqual(GeNuSys::Tests::CycleSet(getExpectedCycles()), GeNuSys::Tests::CycleSet(numSys.getCycles(options)), "File backed cycle search matches in-memory result");
+#ifndef GENUSYS_NO_THREADING
+            GeNuSys::thread_count::set(3);
+            GeNuSys::grain_size::set(1);
+            assertEqual(GeNuSys::Tests::CycleSet(getExpectedCycles()), GeNuSys::Tests::CycleSet(numSys.getCycles(options)), "File backed threaded cycle search matches serial result");
+            GeNuSys::thread_count::set(1);
+            GeNuSys::grain_size::set(4096);
+#endif
+#endif // __unix__
+        }
+
+        static bool resumeFails(NumSysType numSys, const GeNuSys::NumSys::CycleSearchOptions& options)
+        {
+            try
+            {
+                numSys.resumeCycles(options);
+            }
+            catch (const std::runtime_error&)
+            {
+                return true;
+            }
+            return false;
+        }
+
+        void testCheckpoint()
+        {
+            NumSysType numSys = createNumSys(getBase());
+            GeNuSys::NumSys::CycleSearchOptions checkpointOptions;
+            checkpointOptions.checkpointFile = "genusys_test_checkpoint.bin";
+            checkpointOptions.checkpointInterval = 0;
+
+            bool completed = numSys.visitCycles([](const std::vector<GeNuSys::LinAlg::Vector<long long>>&)
+            {
+                return false;
+            }, checkpointOptions);
+            assertFalse(completed, "Interrupted cycle search does not complete");
+            assertTrue(std::ifstream(checkpointOptions.checkpointFile).good(), "Interrupted cycle search leaves a checkpoint");
+
+            GeNuSys::NumSys::CycleSearchOptions otherOptions = checkpointOptions;
+            otherOptions.sieveStartPoints = !checkpointOptions.sieveStartPoints;
+            assertTrue(resumeFails(numSys, otherOptions), "Checkpoint of other search options is rejected");
+            assertTrue(resumeFails(createNumSys(getSieveBase()), checkpointOptions), "Checkpoint of another number system is rejected");
+
+            assertEqual(GeNuSys::Tests::CycleSet(getExpectedCycles()), GeNuSys::Tests::CycleSet(numSys.resumeCycles(checkpointOptions)), "Resumed cycle search matches serial result");
+            assertFalse(std::ifstream(checkpointOptions.checkpointFile).good(), "Completed cycle search removes the checkpoint");
+
+#ifndef GENUSYS_NO_THREADING
+            GeNuSys::thread_count::set(3);
+            GeNuSys::grain_size::set(1);
+            assertEqual(GeNuSys::Tests::CycleSet(getExpectedCycles()), GeNuSys::Tests::CycleSet(numSys.getCycles(checkpointOptions)), "Checkpointed threaded cycle search matches serial result");
+            assertFalse(std::ifstream(checkpointOptions.checkpointFile).good(), "Completed threaded cycle search removes the checkpoint");
+            GeNuSys::thread_count::set(1);
+            GeNuSys::grain_size::set(4096);
+#endif
+            std::remove(checkpointOptions.checkpointFile.c_str());
+        }
+
+        void testLookupHash()
+        {
+            GeNuSys::LinAlg::Matrix<long long> smithBase(2, 2, std::vector<long long> {2, 4, -2, 2});
+            GeNuSys::NumSys::RadixProperties<long long> smithProps(smithBase);
+            GeNuSys::NumSys::SmithHash<long long, GeNuSys::LinAlg::Matrix> smithHash(smithProps);
+            GeNuSys::NumSys::LookupHash lookupHash(smithHash, 2, 5);
+            assertTrue(lookupHash.isEnabled(), "Lookup hash is enabled for small Smith invariants");
+
+            GeNuSys::LinAlg::Vector<long long> z(2);
+            GeNuSys::LinAlg::Vector<long long> Uz = smithHash.createCache();
+            unsigned int mismatches = 0;
+            for (long long a = -7; a <= 7; ++a)
+            {
+                for (long long b = -7; b <= 7; ++b)
+                {
+                    z.set(0, a);
+                    z.set(1, b);
+                    unsigned long long h;
+                    bool inRange = (a >= -5 && a <= 5 && b >= -5 && b <= 5);
+                    mismatches += (lookupHash(z, h) != inRange) || (inRange && h != (unsigned long long) smithHash(z, Uz));
+                }
+            }
+            assertEqual(0u, mismatches, "Lookup hash matches Smith hash");
+        }
+
+        void testHashTable()
+        {
+            GeNuSys::NumSys::RadixProperties<long long> props(getBase());
+            GeNuSys::NumSys::SmithHash<long long, GeNuSys::LinAlg::Matrix> smithHash(props);
+            std::vector<GeNuSys::LinAlg::SparseVector<long long>> digits = GeNuSys::NumSys::DigitSet::getJSymmetric(props, 0);
+            GeNuSys::NumSys::HashTable<long long, GeNuSys::LinAlg::SparseVector, GeNuSys::LinAlg::Matrix> table(smithHash, digits);
+            assertTrue(table.isComplete(), "j-symmetric digit set is complete");
+
+            // Replaces the last digit by a point congruent to the first one
+            std::vector<GeNuSys::LinAlg::SparseVector<long long>> congruentDigits = digits;
+            GeNuSys::LinAlg::Vector<long long> shift(2);
+            shift.set(0, 1);
+            congruentDigits.back() = GeNuSys::LinAlg::Vector<long long>(digits.front()) + props.getBase() * shift;
+            GeNuSys::NumSys::HashTable<long long, GeNuSys::LinAlg::SparseVector, GeNuSys::LinAlg::Matrix> congruentTable(smithHash, congruentDigits);
+            assertFalse(congruentTable.isComplete(), "Congruent digits are detected");
+            assertTrue(GeNuSys::Tests::TestUtils::equals(GeNuSys::LinAlg::Vector<long long>(digits.front()), congruentTable(GeNuSys::LinAlg::Vector<long long>(congruentDigits.back()))),
+                       "The first of the congruent digits is kept");
+
+            GeNuSys::NumSys::RadixProperties<long long> shortProps(getShortBase());
+            GeNuSys::NumSys::SmithHash<long long, GeNuSys::LinAlg::Matrix> shortHash(shortProps);
+            GeNuSys::NumSys::HashTable<long long, GeNuSys::LinAlg::Vector, GeNuSys::LinAlg::Matrix> shortTable(shortHash, getShortDigits());
+            assertFalse(shortTable.isComplete(), "Residues without a digit are detected");
+            assertTrue(throwsLogicError(shortTable, 2), "Index throws for a residue without a digit");
+
+            std::vector<GeNuSys::LinAlg::SparseVector<long long>> shortDigits;
+            for (const GeNuSys::LinAlg::Vector<long long>& digit : getShortDigits())
+            {
+                shortDigits.push_back(digit);
+            }
+            NumSysType shortNumSys(shortProps, shortDigits, shortProps.getOperatorNorm());
+            assertTrue(throwsLogicError(shortNumSys), "The cycle search throws for a digit set with fewer digits than |det|");
+        }
+
+        static bool throwsLogicError(const GeNuSys::NumSys::HashTable<long long, GeNuSys::LinAlg::Vector, GeNuSys::LinAlg::Matrix>& table, long long a)
+        {
+            GeNuSys::LinAlg::Vector<long long> z(2);
+            z.set(0, a);
+            try
+            {
+                table(z);
+            }
+            catch (const std::logic_error&)
+            {
+                return true;
+            }
+
+            return false;
+        }
+
+        static bool throwsLogicError(NumSysType numSys)
+        {
+            // Every point of the box is walked, the ones congruent to (2, 0) have no digit
+            GeNuSys::NumSys::CycleSearchOptions options;
+            options.sieveStartPoints = false;
+            try
+            {
+                numSys.getCycles(options, GeNuSys::NumSys::VectorCoder(std::vector<int>(2, -3), std::vector<int>(2, 3)));
+            }
+            catch (const std::logic_error&)
+            {
+                return true;
+            }
+
+            return false;
+        }
+
+        void testFixedPhiOverflow()
+        {
+            // adjoint * (z - digit) of the first point is (-2^25, 12 - 2^64), which wraps around to a point of the box
+            GeNuSys::LinAlg::Matrix<long long> shearBase(2, 2, std::vector<long long> {2, 0, 1LL << 40, -2});
+            GeNuSys::NumSys::RadixProperties<long long> shearProps(shearBase);
+            GeNuSys::NumSys::SmithHash<long long, GeNuSys::LinAlg::Matrix> shearHash(shearProps);
+            std::vector<GeNuSys::LinAlg::Vector<long long>> shearDigits(4, GeNuSys::LinAlg::Vector<long long>(2));
+            shearDigits[0].set(0, -2);
+            shearDigits[1].set(0, 1);
+            shearDigits[2].set(1, 1);
+            shearDigits[3].set(0, 1);
+            shearDigits[3].set(1, 1);
+            GeNuSys::NumSys::VectorCoder shearCoder(std::vector<int>(2, -(1 << 25)), std::vector<int>(2, 1 << 25));
+            GeNuSys::NumSys::FixedPhi<2> shearPhi(shearProps, shearHash, shearDigits, shearCoder);
+            assertTrue(shearPhi.isComplete(), "Shear digit set is complete");
+
+            long long shearZ[2][1] = {{(1LL << 24) - 2}, {6}};
+            unsigned long long shearCode;
+            bool shearValid;
+            shearPhi.step(shearZ, &shearCode, &shearValid);
+            assertFalse(shearValid, "Fixed phi detects overflowing steps");
+
+            shearZ[0][0] = 1;
+            shearZ[1][0] = 4;
+            shearPhi.step(shearZ, &shearCode, &shearValid);
+            assertTrue(shearValid, "Fixed phi keeps steps which do not overflow");
+            assertEqual(0LL, shearZ[0][0], "First coordinate of a checked step");
+            assertEqual(-2LL, shearZ[1][0], "Second coordinate of a checked step");
+
+            GeNuSys::NumSys::RadixProperties<long long> shortProps(getShortBase());
+            GeNuSys::NumSys::SmithHash<long long, GeNuSys::LinAlg::Matrix> shortHash(shortProps);
+            GeNuSys::NumSys::FixedPhi<2> shortPhi(shortProps, shortHash, getShortDigits(), GeNuSys::NumSys::VectorCoder(std::vector<int>(2, -3), std::vector<int>(2, 3)));
+            assertFalse(shortPhi.isComplete(), "Fixed phi detects residues without a digit");
+        }
+
+        template <typename ElementType>
+        static std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> getShearCycles()
+        {
+            // Above the dimensions of FixedPhi, adjoint * (z - digit) of the points with z[0] = +-4 is -+2^64 + 2 * z[1] - digit,
+            // which wraps around to a fixed point in long long
+            const unsigned int N = GENUSYS_FIXED_PHI_MAX_DIM + 1;
+            GeNuSys::LinAlg::Matrix<ElementType> shearBase = GeNuSys::LinAlg::Matrix<ElementType>::identity(N, N);
+            shearBase.set(1, 0, GeNuSys::ElementTraits<long long>::asType<ElementType>(1LL << 62));
+            shearBase.set(1, 1, 2);
+            GeNuSys::NumSys::RadixProperties<ElementType> shearProps(shearBase);
+            GeNuSys::NumSys::NumberSystem<ElementType, GeNuSys::LinAlg::SparseVector, GeNuSys::LinAlg::Matrix, GeNuSys::LinAlg::OperatorNorm<typename GeNuSys::ElementTraits<ElementType>::RationalType>>
+                    shearNumSys(shearProps, GeNuSys::NumSys::DigitSet::getJSymmetric(shearProps, 1), shearProps.getOperatorNorm());
+
+            std::vector<int> lowerBound(N, 0), upperBound(N, 0);
+            lowerBound[0] = -4;
+            upperBound[0] = 4;
+            lowerBound[1] = -3;
+            upperBound[1] = 3;
+            lowerBound[N - 1] = -1;
+            upperBound[N - 1] = 1;
+
+            // The base is not expansive, so every start point is walked
+            GeNuSys::NumSys::CycleSearchOptions options;
+            options.sieveStartPoints = false;
+
+            return shearNumSys.getCycles(options, GeNuSys::NumSys::VectorCoder(lowerBound, upperBound));
+        }
+
+        void testGenericPhiOverflow()
+        {
+            std::vector<std::vector<GeNuSys::LinAlg::Vector<mpz_class>>> expected = getShearCycles<mpz_class>();
+            assertEqual(6u, (unsigned int) expected.size(), "Fixed points of the shear base");
+            assertEqual(GeNuSys::Tests::CycleSet(expected), GeNuSys::Tests::CycleSet(getShearCycles<long long>()), "Generic phi redoes overflowing steps in mpz_class");
+        }
+
+        template <typename ElementType>
+        static std::vector<std::vector<GeNuSys::LinAlg::Vector<ElementType>>> getSieveCycles()
+        {
+            GeNuSys::NumSys::RadixProperties<ElementType> sieveProps(GeNuSys::LinAlg::Traits::convertUnsafe<long long, ElementType>(getSieveBase()));
+            GeNuSys::NumSys::NumberSystem<ElementType, GeNuSys::LinAlg::SparseVector, GeNuSys::LinAlg::Matrix, GeNuSys::LinAlg::OperatorNorm<typename GeNuSys::ElementTraits<ElementType>::RationalType>>
+                    sieveNumSys(sieveProps, GeNuSys::NumSys::DigitSet::getJSymmetric(sieveProps, 0), sieveProps.getOperatorNorm());
+
+            return sieveNumSys.getCycles();
+        }
+
+        template <typename ElementType>
+        static GeNuSys::LinAlg::Matrix<mpz_class> getSieveTransformation()
+        {
+            GeNuSys::NumSys::RadixProperties<ElementType> sieveProps(GeNuSys::LinAlg::Traits::convertUnsafe<long long, ElementType>(getSieveBase()));
+            srand(1);
+
+            return GeNuSys::LinAlg::Traits::convertUnsafe<ElementType, mpz_class>(GeNuSys::NumSys::Traits::findBasisTransformation(sieveProps.getInverse(),
+                    GeNuSys::NumSys::DigitSet::getJSymmetric(sieveProps, 0), 5, 3, 2));
+        }
+
+        void testInt128()
+        {
+#ifdef __SIZEOF_INT128__
+            const GeNuSys::Int128 wideShear = (GeNuSys::Int128) 1 << 70;
+            GeNuSys::LinAlg::Matrix<GeNuSys::Int128> wideBase(2, 2);
+            wideBase.set(0, 0, 2);
+            wideBase.set(1, 0, wideShear);
+            wideBase.set(1, 1, -2);
+            GeNuSys::NumSys::RadixProperties<GeNuSys::Int128> wideProps(wideBase);
+            std::vector<GeNuSys::LinAlg::Vector<GeNuSys::Int128>> wideDigits(4, GeNuSys::LinAlg::Vector<GeNuSys::Int128>(2));
+            wideDigits[0].set(0, -2);
+            wideDigits[1].set(0, 1);
+            wideDigits[2].set(1, 1);
+            wideDigits[3].set(0, 1);
+            wideDigits[3].set(1, 1);
+            GeNuSys::NumSys::NumberSystem<GeNuSys::Int128, GeNuSys::LinAlg::Vector, GeNuSys::LinAlg::Matrix, GeNuSys::LinAlg::OperatorNorm<GeNuSys::ElementTraits<GeNuSys::Int128>::RationalType>>
+                    wideNumSys(wideProps, wideDigits, wideProps.getOperatorNorm());
+            GeNuSys::LinAlg::Vector<GeNuSys::Int128> wideZ(2);
+            wideZ.set(0, 2);
+            wideZ.set(1, 6);
+            GeNuSys::LinAlg::Vector<GeNuSys::Int128> widePhiZ = wideNumSys.phi(wideZ);
+            assertTrue(wideProps.getAdjoint()(1, 0) == -wideShear, "Int128 adjoint entries beyond long long");
+            assertTrue(widePhiZ[0] == 2, "First coordinate of Int128 phi");
+            assertTrue(widePhiZ[1] == wideShear - 3, "Second coordinate of Int128 phi");
+
+            const GeNuSys::Int128 minValue = (GeNuSys::Int128) ((GeNuSys::UInt128) 1 << 127);
+            assertTrue(GeNuSys::ElementTraits<mpz_class>::asType<GeNuSys::Int128>(-(mpz_class(1) << 127)) == minValue, "Smallest Int128 converts from mpz_class");
+            assertTrue(GeNuSys::ElementTraits<mpz_class>::asType<GeNuSys::Int128>((mpz_class(1) << 127) - 1) == -(minValue + 1), "Largest Int128 converts from mpz_class");
+            bool thrown = false;
+            try
+            {
+                GeNuSys::ElementTraits<mpz_class>::asType<GeNuSys::Int128>(mpz_class(1) << 127);
+            }
+            catch (const std::out_of_range&)
+            {
+                thrown = true;
+            }
+            assertTrue(thrown, "Conversion of 2^127 to Int128 throws");
+
+            assertEqual(GeNuSys::Tests::CycleSet(getSieveCycles<mpz_class>()), GeNuSys::Tests::CycleSet(getSieveCycles<GeNuSys::Int128>()), "Int128 cycles match mpz_class");
+            assertTrue(getSieveTransformation<mpz_class>() == getSieveTransformation<GeNuSys::Int128>(), "Int128 basis transformation matches mpz_class");
+#endif // __SIZEOF_INT128__
+        }
+
+        void testSieve()
+        {
+            GeNuSys::NumSys::RadixProperties<long long> sieveProps(getSieveBase());
+            std::vector<GeNuSys::LinAlg::SparseVector<long long>> sieveDigits = GeNuSys::NumSys::DigitSet::getJSymmetric(sieveProps, 0);
+            std::vector<int> lowerBound, upperBound;
+            GeNuSys::NumSys::Traits::getBounds(sieveProps.getInverse(), sieveDigits, lowerBound, upperBound);
+            GeNuSys::NumSys::VectorCoder sieveCoder(lowerBound, upperBound);
+            GeNuSys::NumSys::AttractorSieve sieve(sieveProps, sieveDigits, sieveCoder);
+            NumSysType sieveNumSys(sieveProps, sieveDigits, sieveProps.getOperatorNorm());
+            GeNuSys::NumSys::CycleSearchOptions noSieve;
+            noSieve.sieveStartPoints = false;
+            CyclesType sieveCycles = sieveNumSys.getCycles(noSieve);
+
+            unsigned int sievedCyclePoints = 0;
+            for (unsigned int i = 0; i < sieveCycles.size(); ++i)
+            {
+                for (unsigned int j = 0; j < sieveCycles[i].size(); ++j)
+                {
+                    bool valid;
+                    sievedCyclePoints += sieve(sieveCoder.encode(sieveCycles[i][j], valid));
+                }
+            }
+            assertEqual(0u, sievedCyclePoints, "Attractor sieve skips only non-periodic points");
+            assertLess(sieveCoder.getSize(), sieve.getCandidateCount(), "Attractor sieve skips points of the box");
+            assertEqual(GeNuSys::Tests::CycleSet(sieveCycles), GeNuSys::Tests::CycleSet(sieveNumSys.getCycles()), "Attractor sieve keeps the cycles");
+        }
+
+        void testBoundedMemory()
+        {
+            NumSysType sieveNumSys = createNumSys(getSieveBase());
+            GeNuSys::NumSys::CycleSearchOptions noSieve;
+            noSieve.sieveStartPoints = false;
+            GeNuSys::NumSys::CycleSearchOptions boundedOptions;
+            boundedOptions.boundedMemory = true;
+            assertEqual(GeNuSys::Tests::CycleSet(sieveNumSys.getCycles(noSieve)), GeNuSys::Tests::CycleSet(sieveNumSys.getCycles(boundedOptions)), "Brent cycle detection finds the same cycles");
+        }
+
+        void testLanes()
+        {
+            // Brent cycle detection walks a single orbit, the visited set scans walk GENUSYS_FIXED_PHI_LANES at once
+            NumSysType sieveNumSys = createNumSys(getSieveBase());
+            GeNuSys::NumSys::CycleSearchOptions serialOptions;
+            serialOptions.boundedMemory = true;
+            GeNuSys::Tests::CycleSet serialCycles(sieveNumSys.getCycles(serialOptions));
+            GeNuSys::NumSys::CycleSearchOptions noSieve;
+            noSieve.sieveStartPoints = false;
+            assertEqual(serialCycles, GeNuSys::Tests::CycleSet(sieveNumSys.getCycles(noSieve)), "Lane scan matches the serial scan");
+            assertEqual(serialCycles, GeNuSys::Tests::CycleSet(sieveNumSys.getCycles()), "Sieved lane scan matches the serial scan");
+#ifndef GENUSYS_NO_THREADING
+            GeNuSys::thread_count::set(3);
+            GeNuSys::grain_size::set(7);
+            assertEqual(serialCycles, GeNuSys::Tests::CycleSet(sieveNumSys.getCycles(noSieve)), "Threaded lane scan matches the serial scan");
+            GeNuSys::thread_count::set(1);
+            GeNuSys::grain_size::set(4096);
+#endif
+        }
+
+        void testCoders()
+        {
+            GeNuSys::NumSys::RadixProperties<long long> sieveProps(getSieveBase());
+            std::vector<GeNuSys::LinAlg::SparseVector<long long>> sieveDigits = GeNuSys::NumSys::DigitSet::getJSymmetric(sieveProps, 0);
+            std::vector<int> lowerBound, upperBound;
+            GeNuSys::NumSys::Traits::getBounds(sieveProps.getInverse(), sieveDigits, lowerBound, upperBound);
+            GeNuSys::NumSys::AttractorSieve sieve(sieveProps, sieveDigits, GeNuSys::NumSys::VectorCoder(lowerBound, upperBound));
+            NumSysType sieveNumSys(sieveProps, sieveDigits, sieveProps.getOperatorNorm());
+            GeNuSys::NumSys::CycleSearchOptions noSieve;
+            noSieve.sieveStartPoints = false;
+
+            GeNuSys::NumSys::PolytopeCoder polytopeCoder(sieveProps, sieveDigits);
+            assertEqual(sieve.getCandidateCount(), polytopeCoder.getSize(), "Polytope coder encodes the sieve candidates");
+            assertEqual(GeNuSys::Tests::CycleSet(sieveNumSys.getCycles(noSieve)), GeNuSys::Tests::CycleSet(sieveNumSys.getCycles(noSieve, polytopeCoder)), "Polytope coder keeps the cycles");
+
+            // The corner of the box is far from the attractor
+            GeNuSys::LinAlg::Vector<long long> corner(3);
+            polytopeCoder.getBox().decode(0, corner);
+            bool inside = true;
+            polytopeCoder.encode(corner, inside);
+            bool thrown = false;
+            try
+            {
+                polytopeCoder.increment(corner);
+            }
+            catch (const std::logic_error&)
+            {
+                thrown = true;
+            }
+            assertFalse(inside, "Polytope coder rejects the corner of its box");
+            assertTrue(thrown, "Polytope coder does not increment points outside of its domain");
+
+            GeNuSys::LinAlg::Matrix<long long> ballBase(2, 2, std::vector<long long> {0, -17, 1, -8});
+            GeNuSys::NumSys::RadixProperties<long long> ballProps(ballBase);
+            std::vector<GeNuSys::LinAlg::SparseVector<long long>> ballDigits = GeNuSys::NumSys::DigitSet::getJSymmetric(ballProps, 0);
+            GeNuSys::NumSys::EllipsoidCoder ellipsoidCoder(ballProps, ballDigits);
+            NumSysType ballNumSys(ballProps, ballDigits, ballProps.getOperatorNorm());
+            assertLess(ellipsoidCoder.getBox().getSize(), ellipsoidCoder.getSize(), "Ellipsoid coder is smaller than its box");
+            assertEqual(GeNuSys::Tests::CycleSet(ballNumSys.getCycles()), GeNuSys::Tests::CycleSet(ballNumSys.getCycles(noSieve, ellipsoidCoder)), "Ellipsoid coder keeps the cycles");
+
+            EmptyCoder emptyCoder(ellipsoidCoder.getLowerBound(), ellipsoidCoder.getUpperBound());
+            GeNuSys::NumSys::CycleSearchOptions boundedMemory;
+            boundedMemory.boundedMemory = true;
+            assertEqual(0ULL, emptyCoder.getSize(), "Empty coder has no points");
+            assertEqual(0u, (unsigned int) ballNumSys.getCycles(noSieve, emptyCoder).size(), "An empty domain has no cycles");
+            assertEqual(0u, (unsigned int) ballNumSys.getCycles(boundedMemory, emptyCoder).size(), "An empty domain has no cycles in bounded memory");
+        }
+
+        void testBasisTransformation()
+        {
+            GeNuSys::NumSys::RadixProperties<long long> sieveProps(getSieveBase());
+            std::vector<GeNuSys::LinAlg::SparseVector<long long>> sieveDigits = GeNuSys::NumSys::DigitSet::getJSymmetric(sieveProps, 0);
+            std::vector<int> lowerBound, upperBound;
+            GeNuSys::NumSys::Traits::getBounds(sieveProps.getInverse(), sieveDigits, lowerBound, upperBound);
+            const unsigned long long boxSize = GeNuSys::NumSys::VectorCoder(lowerBound, upperBound).getSize();
+
+            srand(1);
+            GeNuSys::LinAlg::Matrix<RationalType> transformation = GeNuSys::NumSys::Traits::findBasisTransformation(sieveProps.getInverse(), sieveDigits, 5, 3, 2);
+            assertLessOrEqual(boxSize, GeNuSys::NumSys::Traits::getVolume(sieveProps.getInverse(), sieveDigits, transformation), "Basis transformation does not increase the volume");
+#ifndef GENUSYS_NO_THREADING
+            GeNuSys::thread_count::set(3);
+            srand(1);
+            assertTrue(GeNuSys::NumSys::Traits::findBasisTransformation(sieveProps.getInverse(), sieveDigits, 5, 3, 2) == GeNuSys::LinAlg::Traits::template convertUnsafe<RationalType, long long>(transformation),
+                       "Threaded basis transformation search matches serial result");
+            GeNuSys::thread_count::set(1);
+#endif
+
+            GeNuSys::NumSys::BasisSearchOptions basisOptions;
+            basisOptions.seed = 7;
+            srand(2);
+            GeNuSys::LinAlg::Matrix<long long> seededTransformation = GeNuSys::NumSys::Traits::findBasisTransformation(sieveProps.getInverse(), sieveDigits, basisOptions);
+            srand(3);
+            assertTrue(GeNuSys::NumSys::Traits::findBasisTransformation(sieveProps.getInverse(), sieveDigits, basisOptions) == seededTransformation, "Seeded basis transformation search is reproducible");
+
+            GeNuSys::LinAlg::Matrix<long long> reducedTransformation = GeNuSys::NumSys::Traits::reduceBasis(sieveProps.getInverse(), sieveDigits);
+            unsigned long long reducedVolume = GeNuSys::NumSys::Traits::getVolume(sieveProps.getInverse(), sieveDigits, GeNuSys::LinAlg::Traits::template convertUnsafe<long long, RationalType>(reducedTransformation));
+            assertEqual(1.0, std::abs(GeNuSys::LinAlg::Algorithms::det(reducedTransformation)), "Lattice reduced basis transformation is unimodular");
+            assertLess(boxSize, reducedVolume, "Lattice reduced basis transformation reduces the volume");
+            basisOptions.reduceLattice = true;
+            GeNuSys::LinAlg::Matrix<long long> reducedSearch = GeNuSys::NumSys::Traits::findBasisTransformation(sieveProps.getInverse(), sieveDigits, basisOptions);
+            assertLessOrEqual(reducedVolume, GeNuSys::NumSys::Traits::getVolume(sieveProps.getInverse(), sieveDigits, GeNuSys::LinAlg::Traits::template convertUnsafe<long long, RationalType>(reducedSearch)),
+                              "Basis transformation search from the reduced basis does not increase its volume");
+
+            GeNuSys::NumSys::BasisSearchOptions noMutations;
+            noMutations.mutations = 0;
+            GeNuSys::NumSys::BasisSearchOptions noCandidates;
+            noCandidates.candidates = 0;
+            assertTrue(rejectsBasisOptions(sieveProps, sieveDigits, noMutations), "Basis transformation search rejects zero mutations");
+            assertTrue(rejectsBasisOptions(sieveProps, sieveDigits, noCandidates), "Basis transformation search rejects zero candidates");
+
+            // Nearly parallel unit vectors, the inner products differ from 1 by eps
+            const unsigned int N = 4;
+            GeNuSys::LinAlg::Matrix<double> nearGram(N, N), singularGram(N, N);
+            for (unsigned int i = 0; i < N; ++i)
+            {
+                for (unsigned int j = 0; j < N; ++j)
+                {
+                    nearGram.set(i, j, (i == j) ? 1.0 : 1.0 - 1e-10);
+                    singularGram.set(i, j, 1.0);
+                }
+            }
+            const GeNuSys::LinAlg::Matrix<long long> identity = GeNuSys::LinAlg::Matrix<long long>::identity(N, N);
+            GeNuSys::LinAlg::Matrix<long long> nearBasis = identity;
+            bool reduced = GeNuSys::LinAlg::Algorithms::reduceLLL(nearBasis, nearGram);
+            assertTrue(reduced && std::abs(GeNuSys::LinAlg::Algorithms::det(nearBasis)) == 1.0, "LLL reduces a near-degenerate basis");
+            nearBasis = identity;
+            reduced = GeNuSys::LinAlg::Algorithms::reduceLLL(nearBasis, nearGram, false, 0.99, 2);
+            assertTrue(!reduced && nearBasis == identity, "LLL returns the unreduced basis after its iteration limit");
+            GeNuSys::LinAlg::Matrix<long long> singularBasis = identity;
+            reduced = GeNuSys::LinAlg::Algorithms::reduceLLL(singularBasis, singularGram);
+            assertTrue(!reduced && singularBasis == identity, "LLL returns the unreduced basis for a singular inner product");
+        }
+
+        static bool rejectsBasisOptions(const GeNuSys::NumSys::RadixProperties<long long>& props, const std::vector<GeNuSys::LinAlg::SparseVector<long long>>& digits,
+                                        const GeNuSys::NumSys::BasisSearchOptions& options)
+        {
+            try
+            {
+                GeNuSys::NumSys::Traits::findBasisTransformation(props.getInverse(), digits, options);
+            }
+            catch (const std::invalid_argument&)
+            {
+                return true;
+            }
+
+            return false;
+        }
+
+        void testExactBounds()
+        {
+            GeNuSys::LinAlg::Matrix<mpz_class> exactBase(3, 3, std::vector<mpz_class> {0, 0, -7, 1, 0, 1, 0, 1, 6});
+            GeNuSys::NumSys::RadixProperties<mpz_class> exactProps(exactBase);
+            std::vector<GeNuSys::LinAlg::SparseVector<mpz_class>> exactDigits = GeNuSys::NumSys::DigitSet::getJSymmetric(exactProps, 0);
+            std::vector<int> exactLowerBound, exactUpperBound;
+            GeNuSys::NumSys::Traits::getBounds(exactProps.getInverse(), exactDigits, exactLowerBound, exactUpperBound);
+            std::vector<mpq_class> exactLower, exactUpper;
+            GeNuSys::NumSys::Traits::getEnclosure(exactProps.getInverse(), exactDigits, GeNuSys::LinAlg::Matrix<mpq_class>::identity(3, 3), exactLower, exactUpper);
+            unsigned int mismatches = 0;
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                mismatches += (exactLowerBound[i] != std::ceil(exactLower[i].get_d()) || exactUpperBound[i] != std::floor(exactUpper[i].get_d()));
+            }
+            assertEqual(0u, mismatches, "Bounds summed in integers match the rational enclosure");
+        }
+
+        void run()
+        {
+            testCycles();
+            testVisitor();
+            testThreading();
+            testVisitedSetFile();
+            testCheckpoint();
+            testLookupHash();
+            testHashTable();
+            testFixedPhiOverflow();
+            testGenericPhiOverflow();
+            testInt128();
+            testSieve();
+            testBoundedMemory();
+            testLanes();
+            testCoders();
+            testBasisTransformation();
+            testExactBounds();
+        }
+
+};
+
 /* Hátralévő
  * matrix::diag(vec)
  *    template<typename ElementType>